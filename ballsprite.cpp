@@ -0,0 +1,50 @@
+/* ballsprite.cpp */
+
+#include <map>
+#include <vector>
+#include <QImage>
+#include <QPainter>
+#include <QRadialGradient>
+
+#include "ballsprite.h"
+
+using namespace std;
+
+//draws one variant; this is what Circle::paintEvent used to do on every paint
+static void DrawBall(QImage &image, const int &r, const int & /* style */, const int &subx, const int &suby)
+{
+	image = QImage(r*2+4, r*2+4, QImage::Format_ARGB32_Premultiplied);
+	image.fill(0);
+	
+	QPainter painter(&image);
+	painter.translate( (double)subx / BALL_SUBPIXELS, (double)suby / BALL_SUBPIXELS );
+	
+	QRadialGradient gradient(QPointF(r*3/2,r*3/2), r, QPointF(r/3,r/3) );
+	gradient.setColorAt(0.0, QColor(0,0,255) );
+	gradient.setColorAt(1.0, QColor(255,0,0) );
+
+	painter.setRenderHint(QPainter::Antialiasing, 1);
+	painter.setPen(Qt::lightGray);
+	painter.setBrush(gradient);
+	painter.drawEllipse( QRect(1, 1, r*2+1, r*2+1) );
+}
+
+const QImage& BallSprite(const int &r, const int &style, const int &subx, const int &suby)
+{
+	//every variant of a radius and style is made at once, the first time
+	static map< int, vector< QImage > > cache;
+	
+	vector< QImage > &sprites = cache[ r*BALL_STYLES + style ];
+	if( sprites.empty() )
+	{
+		sprites.resize(BALL_SUBPIXELS*BALL_SUBPIXELS);
+		for( int y = 0; y < BALL_SUBPIXELS; y++ )
+		{
+			for( int x = 0; x < BALL_SUBPIXELS; x++ )
+			{
+				DrawBall(sprites[ y*BALL_SUBPIXELS + x ], r, style, x, y);
+			}
+		}
+	}
+	return sprites[ suby*BALL_SUBPIXELS + subx ];
+}
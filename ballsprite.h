@@ -0,0 +1,28 @@
+/* ballsprite.h */
+
+#ifndef BALLSPRITE_H
+#define BALLSPRITE_H
+
+#include <cmath>
+#include <QImage>
+
+//looks a ball can be drawn with
+enum BALL_STYLE {
+	BALL_GRADIENT = 0,//blue fading to red, with a light gray rim (the original ball)
+	BALL_STYLES = 1
+};
+
+const int BALL_SUBPIXELS = 4;//steps per pixel the sprites are offset by, in each axis
+
+//the ball, prebaked: one premultiplied image per radius, style and subpixel
+//offset, made the first time it's asked for and kept from then on. drawing a
+//ball is then a single blit of BallSprite() at the ball's whole-pixel position.
+//each image is 2*r+4 pixels square, with the ball's box 1 pixel (plus the
+//offset) in from the top-left corner.
+const QImage& BallSprite(const int &r, const int &style, const int &subx, const int &suby);
+
+//which subpixel variant a coordinate falls on; the fraction is taken from the
+//pixel below (floor), so a ball past the top or left edge still gets 0..BALL_SUBPIXELS-1
+inline int BallSubpixel(const double &v) { return (int)((v - floor(v)) * BALL_SUBPIXELS) % BALL_SUBPIXELS; }
+
+#endif //BALLSPRITE_H
@@ -0,0 +1,186 @@
+//* batch.cpp *//
+
+//plays lots of games headless, across every core (see BatchRunner), for tuning
+//levels. the games go round the stages in MAPSTR that have tiles, each with a
+//seed of its own and the ball's start jittered the way NextStage() does it,
+//and the pad is flown by the autopilot. for every stage it reports how the
+//games ended, how long they lasted, how many tiles were cleared, and how often
+//each tile type was hit; with -v, every game gets a line of its own too.
+//
+//with -scale it plays the same games again on 1, 2, 4.. threads, up to one per
+//core, reports the throughput of each, and checks every run came out the same.
+//with -fixed the games are played in fixed point (see World::fixed), so the
+//report is the same whatever machine or compiler it came from; with -float
+//they're played in float (see World::single).
+//
+//this is headless, so it doesn't need Qt; build it on its own with i.e
+//
+//	g++ -std=c++14 -O2 -pthread batch.cpp batchrunner.cpp world.cpp jobsystem.cpp body.cpp bodyset.cpp broadphase.cpp replaylog.cpp tilegrid.cpp sparsetiles.cpp levelfile.cpp chunkstore.cpp -o batch
+//
+//and run it as "batch [games] [steps] [-scale] [-fixed|-float] [-v]" (1000 games of at most
+//20000 steps, 200 s of game time, by default).
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <thread>
+#include <chrono>
+
+#include "random.h"
+#include "levels.h"
+#include "batchrunner.h"
+
+using namespace std;
+
+static const char *OUTCOME_NAME[GAME_OUTCOMES] = { "died", "cleared", "timeout" };
+
+//a and b came out the same
+static int Same(const BatchResult &a, const BatchResult &b)
+{
+	return a.outcome == b.outcome && a.steps == b.steps && a.tiles == b.tiles && a.cleared == b.cleared &&
+		   a.padhits == b.padhits && memcmp(a.hits, b.hits, sizeof(a.hits)) == 0 && a.cellhits == b.cellhits;
+}
+
+//plays the runner's games on threads threads; returns how long it took, in ms
+static double Time(BatchRunner &runner, const int &threads)
+{
+	chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+	runner.Run(threads);
+	return chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+}
+
+static long Steps(const BatchRunner &runner)
+{
+	long steps = 0;
+	for( size_t g = 0; g < runner.results.size(); g++ )
+		steps += runner.results[g].steps;
+	return steps;
+}
+
+int main(int argc, char **argv)
+{
+	int games = 1000;
+	long steps = 20000;
+	int scale = 0, verbose = 0, fixed = 0, single = 0;
+	for( int a = 1, n = 0; a < argc; a++ )
+	{
+		if( strcmp(argv[a], "-scale") == 0 )
+			scale = 1;
+		else if( strcmp(argv[a], "-v") == 0 )
+			verbose = 1;
+		else if( strcmp(argv[a], "-fixed") == 0 )
+			fixed = 1;
+		else if( strcmp(argv[a], "-float") == 0 )
+			single = 1;
+		else if( n++ == 0 )
+			games = atoi(argv[a]);
+		else
+			steps = atol(argv[a]);
+	}
+
+	//the stages worth playing
+	vector< int > stages;
+	for( int s = 0; s < STAGES; s++ )
+	{
+		if( MAPSTR[s].find_first_not_of('0') != string::npos )
+			stages.push_back(s);
+	}
+
+	BatchRunner runner;
+	vector< int > stageof;
+	for( int g = 0; g < games; g++ )
+	{
+		Random rng(g + 1);
+		BatchGame game;
+		stageof.push_back( stages[g % stages.size()] );
+		game.level = MAPSTR[ stageof.back() ];
+		game.seed = g + 1;
+		game.x = START_X + (rng.Next()%100-50.0) / 250.0;
+		game.y = START_Y + (rng.Next()%100-50.0) / 250.0;
+		game.padspeed = PAD_STEP;
+		game.swept = 0;
+		game.fixed = fixed;
+		game.single = single;
+		game.steps = steps;
+		game.idle = 0;
+		runner.Add(game);
+	}
+
+	int cores = (int)thread::hardware_concurrency();
+	if( cores <= 0 )
+		cores = 1;
+	double ms = Time(runner, cores);
+	printf("%d games, %ld steps in %.1f ms on %d threads: %.0f games/s, %.2f M steps/s\n\n",
+		   games, Steps(runner), ms, cores, games * 1000.0 / ms, Steps(runner) / ms / 1000.0);
+
+	if( verbose )
+	{
+		printf("%6s %6s %10s %8s %9s %8s %8s\n", "game", "stage", "x", "y", "outcome", "steps", "cleared");
+		for( int g = 0; g < games; g++ )
+		{
+			const BatchResult &r = runner.results[g];
+			printf("%6d %6d %10.3f %8.3f %9s %8ld %5d/%-3d\n", g, stageof[g], runner.games[g].x, runner.games[g].y,
+				   OUTCOME_NAME[r.outcome], r.steps, r.cleared, r.tiles);
+		}
+		printf("\n");
+	}
+
+	//per stage
+	for( size_t s = 0; s < stages.size(); s++ )
+	{
+		int played = 0, outcomes[GAME_OUTCOMES] = { 0 }, hits[TID_COUNT] = { 0 }, padhits = 0;
+		double survived = 0, cleared = 0;
+		int tiles = 0;
+		for( int g = 0; g < games; g++ )
+		{
+			if( stageof[g] != stages[s] )
+				continue;
+			const BatchResult &r = runner.results[g];
+			played++;
+			outcomes[r.outcome]++;
+			survived += r.steps;
+			cleared += r.cleared;
+			tiles = r.tiles;
+			padhits += r.padhits;
+			for( int t = 0; t < TID_COUNT; t++ )
+				hits[t] += r.hits[t];
+		}
+		if( played == 0 )
+			continue;
+
+		printf("stage %d: %d games; %d died, %d cleared, %d timed out; %.0f steps survived and %.1f of %d tiles cleared on average\n",
+			   stages[s], played, outcomes[GAME_DIED], outcomes[GAME_CLEARED], outcomes[GAME_TIMEOUT], survived / played, cleared / played, tiles);
+		printf("  hits per game:  pad %.1f", (double)padhits / played);
+		for( int t = 0; t < TID_COUNT; t++ )
+		{
+			if( hits[t] != 0 )
+				printf(", ID %d %.1f", t, (double)hits[t] / played);
+		}
+		printf("\n");
+	}
+
+	if( scale )
+	{
+		vector< BatchResult > first = runner.results;
+		double base = 0;
+		printf("\n%8s %10s %10s %12s %8s %6s\n", "threads", "ms", "games/s", "M steps/s", "speedup", "same");
+		for( int t = 1; ; t *= 2 )
+		{
+			if( t > cores )
+				t = cores;
+			double tms = Time(runner, t);
+			if( t == 1 )
+				base = tms;
+			int same = 1;
+			for( int g = 0; g < games; g++ )
+				same = same && Same(first[g], runner.results[g]);
+			printf("%8d %10.1f %10.0f %12.2f %7.2fx %6s\n", t, tms, games * 1000.0 / tms, Steps(runner) / tms / 1000.0, base / tms, same ? "yes" : "NO");
+			fflush(stdout);
+			if( t == cores )
+				break;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,182 @@
+//* batchrunner.cpp *//
+
+#include <cstring>
+#include <vector>
+#include <string>
+#include <atomic>
+#include <thread>
+
+#include "vector2.h"
+#include "tilegrid.h"
+#include "world.h"
+#include "worldlistener.h"
+#include "levels.h"
+#include "batchrunner.h"
+
+using namespace std;
+
+//keeps the score of one game
+class BatchListener : public WorldListener
+{
+
+public:
+
+	BatchResult *result;
+	vector< unsigned char > was;//ID of each cell (j*fullcols + i) before it was last hit
+	int cols;
+	int died;
+
+	BatchListener(BatchResult *result_in, const TileGrid *g)
+	{
+		result = result_in;
+		cols = g->fullcols;
+		was.assign(g->fullrows*g->fullcols, TID_EMPTY);
+		died = 0;
+
+		memset(result->hits, 0, sizeof(result->hits));
+		result->padhits = 0;
+		result->tiles = 0;
+		result->cleared = 0;
+		result->cellhits.assign(g->fullrows*g->fullcols, 0);
+		for( int j = 0; j < g->fullrows; j++ )
+		{
+			for( int i = 0; i < g->fullcols; i++ )
+			{
+				int k = g->Index(i, j);
+				was[j*cols + i] = g->id[k];
+				if( g->id[k] != TID_EMPTY && !(g->mat[k] & MAT_UNBREAKABLE) )
+					result->tiles++;
+			}
+		}
+	}
+
+	//the tile has already taken the hit, so what it was is looked up in was
+	void BodyCollided(Body * /* b */, const TileRef &t)
+	{
+		if( t.IsNull() )
+		{
+			result->padhits++;
+			return;
+		}
+		unsigned char &ID = was[t.j*cols + t.i];
+		result->hits[ID]++;
+		result->cellhits[t.j*cols + t.i]++;
+		if( ID != TID_EMPTY && t.ID() == TID_EMPTY )
+			result->cleared++;
+		ID = t.ID();
+	}
+
+	void BodyDied(Body * /* b */) { died = 1; }
+};
+
+//queues a game; returns its index in games (and, after Run(), in results)
+int BatchRunner::Add(const BatchGame &g)
+{
+	games.push_back(g);
+	return (int)games.size() - 1;
+}
+
+//plays every game, on threads threads (one per core if it's 0), and returns
+//when they're all done
+void BatchRunner::Run(const int &threads)
+{
+	int n = threads;
+	if( n <= 0 )
+		n = (int)thread::hardware_concurrency();
+	if( n <= 0 )
+		n = 1;
+	if( n > (int)games.size() )
+		n = (int)games.size();
+
+	results.resize(games.size());
+	next = 0;
+
+	vector< thread > pool;
+	for( int t = 1; t < n; t++ )
+		pool.push_back( thread(&BatchRunner::Work, this) );
+	Work();//this thread is one of the workers
+	for( size_t t = 0; t < pool.size(); t++ )
+		pool[t].join();
+}
+
+//takes games off the counter until there are none left
+void BatchRunner::Work()
+{
+	int n = (int)games.size();
+	for( int g = next++; g < n; g = next++ )
+	{
+		BatchResult r;
+		Play(games[g], r);
+		results[g] = r;//written once, so workers don't fight over the cache lines between results
+	}
+}
+
+//plays one game to the end, in a World set up the way the GameBoard sets one up
+void BatchRunner::Play(const BatchGame &game, BatchResult &result)
+{
+	World world(8, 8, TILERAD, TILERAD);
+	world.tiles->Build();
+	world.Seed(game.seed);
+	world.swept = game.swept;
+	world.fixed = game.fixed;
+	world.single = game.single;
+
+	int k = world.AddBody( Vector2(START_X, START_Y), OBJRAD );
+	world.PlaceBody( k, Vector2(game.x, game.y), Vector2(START_X, START_Y) );
+	world.LoadLevel(game.level);
+
+	world.padx = PAD_X;
+	world.pady = PAD_Y;
+	world.padw = PAD_W;
+
+	BatchListener score(&result, world.tiles);
+	world.SetListener(&score);
+
+	long s = 0;
+	long broke = 0;//when a tile was last broken
+	int cleared = 0;
+	while( !score.died && result.cleared < result.tiles && s < game.steps )
+	{
+		world.padx = Autopilot(world.padx, world.padw, world.bodies.x[k], game.padspeed);
+		world.Step();
+		s++;
+
+		if( cleared != result.cleared )
+		{
+			cleared = result.cleared;
+			broke = s;
+		}
+		else if( 0 < game.idle && game.idle <= s - broke )
+			break;
+	}
+
+	result.steps = s;
+	if( score.died )
+		result.outcome = GAME_DIED;
+	else if( result.cleared >= result.tiles )
+		result.outcome = GAME_CLEARED;
+	else
+		result.outcome = GAME_TIMEOUT;
+}
+
+//where a pad at padx goes next, moving at most speed pixels to get its middle
+//under the ball, and no further than the keys could take it. the same inputs
+//always give the same answer, so autopiloted games are repeatable.
+int BatchRunner::Autopilot(const int &padx, const int &padw, const double &ballx, const int &speed)
+{
+	//the pad catches the ball from padx-20 to padx-13+padw (see Body::CollideCirclevsPad())
+	double want = ballx - (padw - 33) * 0.5;
+	int x = padx;
+	if( speed <= 0 )
+		return x;
+	if( want > x + speed )
+		x += speed;
+	else if( want < x - speed )
+		x -= speed;
+	else
+		x = (int)(want + 0.5);
+
+	if( x < PAD_MINX ) x = PAD_MINX;
+	if( x > PAD_MAXX ) x = PAD_MAXX;
+	return x;
+}
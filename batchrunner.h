@@ -0,0 +1,79 @@
+//* batchrunner.h *//
+
+#ifndef BATCHRUNNER_H
+#define BATCHRUNNER_H
+
+#include <vector>
+#include <string>
+#include <atomic>
+
+#include "tilegrid.h"
+
+//how a game ended
+enum GAME_OUTCOME {
+	GAME_DIED = 0,//the ball fell off the bottom
+	GAME_CLEARED = 1,//every breakable tile was broken
+	GAME_TIMEOUT = 2,//neither, within the steps it was given
+	GAME_OUTCOMES = 3
+};
+
+//one game to play headless: a level, and everything it starts from
+struct BatchGame
+{
+	std::string level;//a level string (see TileGrid::SetTileStates()), i.e MAPSTR[stage]
+	unsigned int seed;//see World::Seed()
+	double x, y;//where the ball is put; it comes from (START_X, START_Y), like in NextStage()
+	int padspeed;//pixels per step the autopilot may move the pad; 0 leaves it where it starts
+	int swept;//see World::swept
+	int fixed;//see World::fixed
+	int single;//see World::single
+	long steps;//the game is called off after this many steps,
+	long idle;//or after this many without a tile broken (the ball is stuck in a loop); 0 never
+};
+
+//what became of a BatchGame
+struct BatchResult
+{
+	int outcome;//GAME_OUTCOME
+	long steps;//steps survived
+	int tiles;//breakable tiles the level started with,
+	int cleared;//and how many of them were broken
+	int hits[TID_COUNT];//collisions with each TILE_ID
+	int padhits;//collisions with the pad (or anything else that isn't a tile)
+	std::vector< int > cellhits;//collisions with each cell, j*fullcols + i
+};
+
+//plays many independent games at once, each in a World of its own, across a
+//pool of threads. the worlds share nothing that changes, so every game plays
+//out exactly the same whatever thread it lands on, and however many there are.
+//
+//the workers take the next game off a shared counter as they finish one, so a
+//long game doesn't hold up the rest, and each writes only its own results.
+class BatchRunner
+{
+
+public:
+
+	std::vector< BatchGame > games;
+	std::vector< BatchResult > results;//one per game, after Run()
+
+	BatchRunner() : next(0) { }
+
+	int Add(const BatchGame &g);
+	void Run(const int &threads = 0);
+
+	static void Play(const BatchGame &game, BatchResult &result);
+	static int Autopilot(const int &padx, const int &padw, const double &ballx, const int &speed);
+
+private:
+
+	std::atomic< int > next;//the first game nobody has taken yet
+
+	void Work();
+
+	BatchRunner(const BatchRunner&);
+	BatchRunner& operator=(const BatchRunner&);
+
+};
+
+#endif //BATCHRUNNER_H
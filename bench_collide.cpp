@@ -0,0 +1,336 @@
+//* bench_collide.cpp *//
+
+//micro-benchmarks for the circle-vs-tile collision code, to catch regressions
+//when it's optimized. there are two suites, each run for all 34 tile IDs:
+//
+//	resolve: a tile alone in the middle of a 3x3 neighborhood, and a circle overlapping
+//	         it from each of the 9 cell offsets (oH,oV); times Body::ResolveCircleTile(),
+//	         i.e every ProjCircle_* kernel, given the penetration as
+//	         Body::CollideCirclevsTileMap() would give it (never 0).
+//
+//	collide: an empty cell surrounded by 8 tiles of one ID, and circles swept over each
+//	         ninth of that cell (so they overlap the tiles on that side, or the corner);
+//	         times Body::CollideCirclevsTileMap().
+//
+//for every case it reports ns per call and, where perf_event_open() is allowed
+//(linux, and usually kernel.perf_event_paranoid <= 2), branch and cache misses
+//per call; otherwise those are reported as null.
+//
+//this is headless, so it doesn't need Qt; build it on its own with i.e
+//
+//	g++ -std=c++14 -O2 bench_collide.cpp body.cpp tilegrid.cpp sparsetiles.cpp levelfile.cpp -o bench_collide
+//
+//and run it as "bench_collide [-json] [reps]"; with -json the results are
+//printed as a JSON object instead of a table.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include <chrono>
+
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#include "body.h"
+#include "tilegrid.h"
+
+using namespace std;
+
+const int SAMPLES = 256;//circle positions per case
+const int TILE_XW = 20;//as in the game (TILERAD, OBJRAD)
+const int RADIUS = 16;
+
+//hardware counters for the calling thread, in user space only
+enum PERF_COUNTER {
+	PERF_BRANCH_MISSES = 0,
+	PERF_CACHE_MISSES = 1,
+	PERF_COUNT = 2
+};
+
+class PerfCounters
+{
+
+public:
+
+	int fd[PERF_COUNT];
+	long long value[PERF_COUNT];
+	int ok;//all counters could be opened
+
+	PerfCounters();
+	~PerfCounters();
+
+	void Start();
+	void Stop();
+
+};
+
+PerfCounters::PerfCounters()
+{
+	ok = 1;
+	for( int c = 0; c < PERF_COUNT; c++ )
+	{
+		fd[c] = -1;
+		value[c] = 0;
+	}
+
+#if defined(__linux__)
+	const unsigned long long config[PERF_COUNT] = { PERF_COUNT_HW_BRANCH_MISSES, PERF_COUNT_HW_CACHE_MISSES };
+	for( int c = 0; c < PERF_COUNT; c++ )
+	{
+		perf_event_attr attr;
+		memset(&attr, 0, sizeof(attr));
+		attr.size = sizeof(attr);
+		attr.type = PERF_TYPE_HARDWARE;
+		attr.config = config[c];
+		attr.disabled = 1;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+
+		fd[c] = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+		if( fd[c] < 0 )
+			ok = 0;
+	}
+#else
+	ok = 0;
+#endif
+}
+
+PerfCounters::~PerfCounters()
+{
+#if defined(__linux__)
+	for( int c = 0; c < PERF_COUNT; c++ )
+	{
+		if( 0 <= fd[c] )
+			close(fd[c]);
+	}
+#endif
+}
+
+void PerfCounters::Start()
+{
+#if defined(__linux__)
+	if( !ok )
+		return;
+	for( int c = 0; c < PERF_COUNT; c++ )
+	{
+		ioctl(fd[c], PERF_EVENT_IOC_RESET, 0);
+		ioctl(fd[c], PERF_EVENT_IOC_ENABLE, 0);
+	}
+#endif
+}
+
+void PerfCounters::Stop()
+{
+#if defined(__linux__)
+	if( !ok )
+		return;
+	for( int c = 0; c < PERF_COUNT; c++ )
+	{
+		ioctl(fd[c], PERF_EVENT_IOC_DISABLE, 0);
+		if( read(fd[c], &value[c], sizeof(value[c])) != sizeof(value[c]) )
+			value[c] = 0;
+	}
+#endif
+}
+
+
+//the result of one case
+struct BenchResult
+{
+	const char *suite;
+	int ID;
+	int oH;
+	int oV;
+	double ns;//per call
+	double branchmisses;//per call, if perf.ok
+	double cachemisses;
+};
+
+//times calls of fn(b, s) for every sample s, reps times over
+template<class F>
+static void Measure(F fn, Body &b, const vector< Vector2 > &samples, const int &reps, PerfCounters &perf, BenchResult &res)
+{
+	volatile int sink = 0;
+	double calls = (double)reps * samples.size();
+
+	perf.Start();
+	chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+	for( int rep = 0; rep < reps; rep++ )
+	{
+		for( int s = 0; s < (int)samples.size(); s++ )
+		{
+			b.pos = samples[s];
+			b.oldpos = samples[s];
+			sink += fn(b, s);
+		}
+	}
+	chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+	perf.Stop();
+
+	res.ns = chrono::duration<double, nano>(t1 - t0).count() / calls;
+	res.branchmisses = perf.value[PERF_BRANCH_MISSES] / calls;
+	res.cachemisses = perf.value[PERF_CACHE_MISSES] / calls;
+}
+
+//a 3x3 map (plus the border) where every tile is unbreakable, so hitting one doesn't change it
+static void FillGrid(TileGrid &grid, const int &centerID, const int &ringID)
+{
+	for( int j = 1; j <= 3; j++ )
+	{
+		for( int i = 1; i <= 3; i++ )
+		{
+			int k = grid.Index(i, j);
+			grid.id[k] = (i == 2 && j == 2) ? centerID : ringID;
+			grid.mat[k] |= MAT_UNBREAKABLE;
+		}
+	}
+	grid.BuildTypes();
+	grid.BuildEdges();
+}
+
+//positions for a circle of radius r in the cell at offset (oH,oV) from the tile t,
+//overlapping t's cell by a little more than 0 up to r on each axis it's offset
+//on, and anywhere in the middle half of the cell on the others; so every sample
+//has something to be projected out of, even in t's own cell (0,0)
+static void ResolveSamples(vector< Vector2 > &samples, const TileRef &t, const int &oH, const int &oV, const int &r)
+{
+	for( int s = 0; s < (int)samples.size(); s++ )
+	{
+		double penx = (1 + rand() % 1000) / 1001.0 * r;
+		double peny = (1 + rand() % 1000) / 1001.0 * r;
+		double jx = (rand() % 1000) / 1000.0 * t.xw();
+		double jy = (rand() % 1000) / 1000.0 * t.yw();
+		samples[s] = Vector2( t.x() + (oH ? oH*(t.xw() + r - penx) : jx - t.xw()/2.0),
+		                      t.y() + (oV ? oV*(t.yw() + r - peny) : jy - t.yw()/2.0) );
+	}
+}
+
+//circle positions in the ninth (h,v) of the cell c; i.e (-1,-1) is the top-left corner
+static void CollideSamples(vector< Vector2 > &samples, const TileRef &c, const int &h, const int &v)
+{
+	double w = 2.0*c.xw() / 3;
+	double ht = 2.0*c.yw() / 3;
+	for( int s = 0; s < (int)samples.size(); s++ )
+	{
+		double jx = (rand() % 1000) / 1000.0 * w;
+		double jy = (rand() % 1000) / 1000.0 * ht;
+		samples[s] = Vector2( c.x() - c.xw() + (h+1)*w + jx, c.y() - c.yw() + (v+1)*ht + jy );
+	}
+}
+
+static void PrintTable(const vector< BenchResult > &results, const int &perfok)
+{
+	const char *suite = "";
+	for( int q = 0; q < (int)results.size(); q++ )
+	{
+		const BenchResult &r = results[q];
+		if( strcmp(suite, r.suite) != 0 )
+		{
+			suite = r.suite;
+			printf("\n[%s]\n%4s %3s %3s %10s %12s %12s\n", suite, "TID", "oH", "oV", "ns/call", "br-miss/call", "$-miss/call");
+		}
+		if( perfok )
+			printf("%4d %3d %3d %10.2f %12.4f %12.4f\n", r.ID, r.oH, r.oV, r.ns, r.branchmisses, r.cachemisses);
+		else
+			printf("%4d %3d %3d %10.2f %12s %12s\n", r.ID, r.oH, r.oV, r.ns, "-", "-");
+	}
+}
+
+static void PrintJSON(const vector< BenchResult > &results, const int &perfok, const int &reps)
+{
+	printf("{\n");
+	printf("  \"tile_xw\": %d,\n  \"radius\": %d,\n  \"samples\": %d,\n  \"reps\": %d,\n  \"perf\": %s,\n", TILE_XW, RADIUS, SAMPLES, reps, perfok ? "true" : "false");
+	printf("  \"results\": [\n");
+	for( int q = 0; q < (int)results.size(); q++ )
+	{
+		const BenchResult &r = results[q];
+		printf("    {\"suite\": \"%s\", \"tid\": %d, \"oH\": %d, \"oV\": %d, \"ns_per_call\": %.3f, ", r.suite, r.ID, r.oH, r.oV, r.ns);
+		if( perfok )
+			printf("\"branch_misses_per_call\": %.5f, \"cache_misses_per_call\": %.5f}", r.branchmisses, r.cachemisses);
+		else
+			printf("\"branch_misses_per_call\": null, \"cache_misses_per_call\": null}");
+		printf("%s\n", (q+1 < (int)results.size()) ? "," : "");
+	}
+	printf("  ]\n}\n");
+}
+
+int main(int argc, char **argv)
+{
+	int json = 0;
+	int reps = 1000;
+	for( int a = 1; a < argc; a++ )
+	{
+		if( strcmp(argv[a], "-json") == 0 )
+			json = 1;
+		else
+			reps = atoi(argv[a]);
+	}
+
+	PerfCounters perf;
+	vector< BenchResult > results;
+	vector< Vector2 > samples( SAMPLES );
+
+	TileGrid grid(3, 3, TILE_XW, TILE_XW);
+	grid.Build();
+	TileRef center = grid.GetTile_I(2, 2);
+
+	Body b(Vector2(0, 0), RADIUS);
+
+	//resolve suite; an empty tile has no kernel, so it starts at 1
+	for( int ID = 1; ID < TID_COUNT; ID++ )
+	{
+		FillGrid(grid, ID, TID_EMPTY);
+		for( int oV = -1; oV <= 1; oV++ )
+		{
+			for( int oH = -1; oH <= 1; oH++ )
+			{
+				srand(ID*9 + (oV+1)*3 + oH+1);
+				ResolveSamples(samples, center, oH, oV, RADIUS);
+
+				BenchResult res = { "resolve", ID, oH, oV, 0, 0, 0 };
+				Measure( [&](Body &body, const int & /* s */) {
+						double px = (center.xw() + body.r) - fabs(body.pos.x - center.x());
+						double py = (center.yw() + body.r) - fabs(body.pos.y - center.y());
+						//as CollideCirclevsTileMap() calls it: both depths for the cell
+						//itself and the corners, only the one across a shared edge
+						return body.ResolveCircleTile((oH || !oV) ? px : 0, (oV || !oH) ? py : 0, oH, oV, &body, center);
+					}, b, samples, reps, perf, res );
+				results.push_back( res );
+			}
+		}
+	}
+
+	//collide suite
+	for( int ID = 0; ID < TID_COUNT; ID++ )
+	{
+		FillGrid(grid, TID_EMPTY, ID);
+		for( int v = -1; v <= 1; v++ )
+		{
+			for( int h = -1; h <= 1; h++ )
+			{
+				srand(1000 + ID*9 + (v+1)*3 + h+1);
+				CollideSamples(samples, center, h, v);
+
+				BenchResult res = { "collide", ID, h, v, 0, 0, 0 };
+				Measure( [&](Body &body, const int & /* s */) {
+						body.CollideCirclevsTileMap(center);
+						return (int)body.pos.x;
+					}, b, samples, reps, perf, res );
+				results.push_back( res );
+			}
+		}
+	}
+
+	if( json )
+		PrintJSON(results, perf.ok, reps);
+	else
+		PrintTable(results, perf.ok);
+
+	return 0;
+}
@@ -0,0 +1,112 @@
+//* bench_load.cpp *//
+
+//times loading a level into a TileGrid, for maps from 8x8 up to 4096x4096 cells;
+//it compares setting every tile through SetTileState() (one cell at a time, the
+//way levels used to be loaded) with the bulk SetTileStates(), and checks that
+//both leave the grid in the same state. it then writes the level out as a binary
+//level file (levelfile.h) and times mapping it back in with LoadLevelFile(),
+//which only has to check the planes once, rather than build them.
+//
+//this is headless, so it doesn't need Qt; build it on its own with i.e
+//
+//	g++ -std=c++14 -O2 bench_load.cpp tilegrid.cpp sparsetiles.cpp levelfile.cpp -o bench_load
+//
+//and run it as "bench_load [maxsize]" (maxsize defaults to 4096).
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <chrono>
+
+#include "tilegrid.h"
+#include "levelfile.h"
+
+using namespace std;
+
+//a level of random tile IDs, about half of them empty
+static string RandomLevel(const int &rows, const int &cols)
+{
+	string level(rows*cols, (char)(TID_EMPTY + CHAR_PAD));
+	for( int k = 0; k < rows*cols; k++ )
+	{
+		if( rand() % 2 )
+			level[k] = (char)(1 + rand() % (TID_COUNT-1) + CHAR_PAD);
+	}
+	return level;
+}
+
+//all 6 planes of a and b hold the same bytes
+static int Same(const TileGrid &a, const TileGrid &b)
+{
+	if( a.Count() != b.Count() )
+		return 0;
+
+	size_t n = a.Count();
+	return !memcmp(a.id, b.id, n) && !memcmp(a.ctype, b.ctype, n) && !memcmp(a.signs, b.signs, n) &&
+		   !memcmp(a.edges, b.edges, n) && !memcmp(a.hp, b.hp, n) && !memcmp(a.mat, b.mat, n);
+}
+
+static double Millis(chrono::steady_clock::time_point t0, chrono::steady_clock::time_point t1)
+{
+	return chrono::duration<double, milli>(t1 - t0).count();
+}
+
+int main(int argc, char **argv)
+{
+	int maxsize = (argc > 1) ? atoi(argv[1]) : 4096;
+	const char *filename = "bench_load.lvl";
+
+	printf("%10s %14s %14s %10s %8s %12s %12s %8s\n", "size", "per-cell ms", "bulk ms", "speedup", "same", "save ms", "mapped ms", "same");
+
+	for( int n = 8; n <= maxsize; n *= 2 )
+	{
+		srand(n);
+		string level = RandomLevel(n, n);
+
+		TileGrid a(n, n, 10, 10);
+		TileGrid b(n, n, 10, 10);
+
+		//both loaders (and Build()) roll a color once per non-empty cell in the
+		//same order, so seeding them the same way should give the same colors too
+		a.rng.Seed(1);
+		a.Build();
+		chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+		for( int i = 0; i < n; i++ )
+		{
+			for( int j = 0; j < n; j++ )
+			{
+				a.SetTileState(i, j, level[ i*n + j ]);
+			}
+		}
+		chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+
+		b.rng.Seed(1);
+		b.Build();
+		chrono::steady_clock::time_point t2 = chrono::steady_clock::now();
+		b.SetTileStates(level);
+		chrono::steady_clock::time_point t3 = chrono::steady_clock::now();
+
+		int same = Same(a, b);
+
+		//the mapped grid starts out the wrong size; the file decides it
+		TileGrid c(1, 1, 10, 10);
+		c.Build();
+		chrono::steady_clock::time_point t4 = chrono::steady_clock::now();
+		int saved = b.SaveLevelFile(filename);
+		chrono::steady_clock::time_point t5 = chrono::steady_clock::now();
+		int loaded = saved && c.LoadLevelFile(filename);
+		chrono::steady_clock::time_point t6 = chrono::steady_clock::now();
+
+		int mapsame = loaded && Same(b, c);
+
+		double slow = Millis(t0, t1);
+		double fast = Millis(t2, t3);
+		printf("%5dx%-4d %14.3f %14.3f %9.2fx %8s %12.3f %12.3f %8s\n", n, n, slow, fast, (fast > 0) ? slow/fast : 0.0, same ? "yes" : "NO",
+			   Millis(t4, t5), Millis(t5, t6), mapsame ? "yes" : "NO");
+		fflush(stdout);
+	}
+
+	remove(filename);
+	return 0;
+}
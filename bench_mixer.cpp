@@ -0,0 +1,236 @@
+//* bench_mixer.cpp *//
+
+//runs the Mixer (mixer.h) without a sound card, through a NullSink. it makes a
+//short "hit" and a long "music" clip (and checks that a .wav written to disk
+//decodes back to the same sound), then:
+//
+//	latency:  plays single hits into silence, in simulated time: the device
+//	          pulls DEVICE-frame buffers on time, the mixer is pumped every
+//	          MIX_PUMP ms, and we measure how long it is from Play() until the
+//	          hit is heard.
+//	storm:    plays music under a hit every step of a 1000 Hz physics loop for
+//	          a few seconds of simulated time, and reports underruns, stolen
+//	          voices, dropped Play()s and the time Update() takes per frame.
+//	threads:  the same, for real, with the physics and the device on threads
+//	          of their own, to check the queue and the ring hold up.
+//
+//this is headless, so it doesn't need Qt; build it on its own with i.e
+//
+//	g++ -std=c++14 -O2 -pthread bench_mixer.cpp mixer.cpp -o bench_mixer
+//
+//and run it as "bench_mixer [seconds]" (3 by default).
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <chrono>
+
+#include "mixer.h"
+
+using namespace std;
+
+const int DEVICE = 256;//frames per buffer the device asks for
+const int PUMP_MS = 5;//as MIX_PUMP (mixerdevice.h)
+const int HITS = 50;
+
+//a tone of the given length, fading out
+static SoundClip Tone(const double &seconds, const double &hz, const int &amp)
+{
+	SoundClip clip;
+	int n = (int)(seconds * MIX_RATE);
+	clip.frames.resize(n*MIX_CHANNELS);
+	for( int f = 0; f < n; f++ )
+	{
+		double a = amp * (1.0 - (double)f / n);
+		short s = (short)( a * sin(2*M_PI*hz*f / MIX_RATE) );
+		if( s == 0 ) s = 1;//never silent, so we can tell when it's heard
+		clip.frames[f*MIX_CHANNELS] = clip.frames[f*MIX_CHANNELS + 1] = s;
+	}
+	return clip;
+}
+
+static void PutU32(unsigned char *p, const unsigned int &v) { p[0] = v; p[1] = v >> 8; p[2] = v >> 16; p[3] = v >> 24; }
+static void PutU16(unsigned char *p, const int &v) { p[0] = v; p[1] = v >> 8; }
+
+//writes clip as a 16-bit stereo .wav at MIX_RATE
+static bool SaveWav(const char *filename, const SoundClip &clip)
+{
+	unsigned int bytes = clip.frames.size()*sizeof(short);
+	unsigned char h[44];
+	memcpy(h, "RIFF", 4);     PutU32(h + 4, 36 + bytes);
+	memcpy(h + 8, "WAVE", 4);
+	memcpy(h + 12, "fmt ", 4); PutU32(h + 16, 16);
+	PutU16(h + 20, 1);         PutU16(h + 22, MIX_CHANNELS);
+	PutU32(h + 24, MIX_RATE);  PutU32(h + 28, MIX_RATE*MIX_CHANNELS*2);
+	PutU16(h + 32, MIX_CHANNELS*2); PutU16(h + 34, 16);
+	memcpy(h + 36, "data", 4); PutU32(h + 40, bytes);
+
+	FILE *f = fopen(filename, "wb");
+	if( f == NULL )
+		return false;
+	bool ok = fwrite(h, 1, 44, f) == 44;
+	for( size_t s = 0; s < clip.frames.size() && ok; s++ )
+	{
+		unsigned char b[2];
+		PutU16(b, (unsigned short)clip.frames[s]);
+		ok = fwrite(b, 1, 2, f) == 2;
+	}
+	return (fclose(f) == 0) && ok;
+}
+
+int main(int argc, char **argv)
+{
+	double seconds = (argc > 1) ? atof(argv[1]) : 3;
+
+	SoundClip hitclip = Tone(0.25, 880, 8000);
+	SoundClip musicclip = Tone(seconds + 1, 220, 6000);
+
+	//decoding
+	const char *filename = "bench_mixer.wav";
+	SoundClip loaded;
+	int decoded = SaveWav(filename, hitclip) && LoadWav(filename, loaded) && loaded.frames == hitclip.frames;
+	remove(filename);
+	printf("decode       %s\n", decoded ? "a written .wav decodes back the same" : "FAILED");
+
+	//latency, in simulated time: a device buffer every DEVICE frames, a pump every PUMP_MS
+	{
+		Mixer mixer;
+		int hit = mixer.Add(hitclip);
+		NullSink sink(&mixer);
+
+		const int PUMP = MIX_RATE * PUMP_MS / 1000;//frames between pumps
+		double worst = 0, total = 0;
+		int heard = 0;
+		long t = 0;
+		mixer.Update();
+		for( int h = 0; h < HITS; h++ )
+		{
+			//wait for silence, then play it at some point between pumps
+			long at = -1;
+			long quiet = 0;
+			for( long step = 0; step < MIX_RATE; step++, t++ )
+			{
+				if( at < 0 && quiet > MIX_RING && step % PUMP == (h*37) % PUMP )
+				{
+					mixer.Play(hit);
+					at = t;
+				}
+				if( t % PUMP == 0 )
+					mixer.Update();
+				if( t % DEVICE == 0 )
+				{
+					long before = sink.loud;
+					long start = sink.frames;
+					sink.Pull(DEVICE);
+					if( sink.loud == before )
+						quiet += DEVICE;
+					else
+					{
+						quiet = 0;
+						if( at >= 0 )
+						{
+							//the first loud frame of this buffer is when it's heard
+							int f = 0;
+							while( sink.buffer[f*MIX_CHANNELS] == 0 )
+								f++;
+							double ms = (start + f - at) * 1000.0 / MIX_RATE;
+							if( worst < ms ) worst = ms;
+							total += ms;
+							heard++;
+							at = -1;
+							t++;//the loop won't, now
+							break;
+						}
+					}
+				}
+			}
+		}
+		printf("latency      %d of %d hits heard, %.1f ms on average, %.1f ms at worst (%d-frame device buffers)\n",
+			   heard, HITS, heard ? total / heard : 0.0, worst, DEVICE);
+	}
+
+	//storm, in simulated time: music, and a hit every millisecond
+	{
+		Mixer mixer;
+		int hit = mixer.Add(hitclip);
+		int music = mixer.Add(musicclip);
+		NullSink sink(&mixer);
+
+		mixer.Play(music);
+		mixer.Update();
+
+		long frames = (long)(seconds * MIX_RATE);
+		const int MS = MIX_RATE / 1000;
+		double updatems = 0;
+		int updates = 0;
+		for( long t = 0; t < frames; t++ )
+		{
+			if( t % MS == 0 )
+				mixer.Play(hit, MIX_UNITY/2);
+			if( t % (MS*PUMP_MS) == 0 )
+			{
+				chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+				mixer.Update();
+				updatems += chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+				updates++;
+			}
+			if( t % DEVICE == 0 )
+				sink.Pull(DEVICE);
+		}
+		printf("storm        %.1f s, %d voices: %d underruns, %d stolen, %d dropped; Update() %.1f us each; peak %d\n",
+			   seconds, MIX_VOICES, mixer.underruns.load(), mixer.stolen, mixer.dropped.load(), updatems * 1000 / updates, sink.peak);
+	}
+
+	//threads, for real: physics and device on their own threads, the mixer on this one
+	{
+		Mixer mixer;
+		int hit = mixer.Add(hitclip);
+		int music = mixer.Add(musicclip);
+		NullSink sink(&mixer);
+
+		mixer.Play(music);
+		mixer.Update();
+
+		atomic< int > running(1);
+		atomic< long > plays(0);
+		thread physics([&]()
+		{
+			while( running.load() )
+			{
+				if( mixer.Play(hit, MIX_UNITY/2) )
+					plays++;
+				this_thread::sleep_for(chrono::milliseconds(1));
+			}
+		});
+		thread device([&]()
+		{
+			chrono::steady_clock::time_point next = chrono::steady_clock::now();
+			while( running.load() )
+			{
+				sink.Pull(DEVICE);
+				next += chrono::microseconds( (long)DEVICE * 1000000 / MIX_RATE );
+				this_thread::sleep_until(next);
+			}
+		});
+
+		chrono::steady_clock::time_point end = chrono::steady_clock::now() + chrono::milliseconds((long)(seconds * 1000));
+		while( chrono::steady_clock::now() < end )
+		{
+			mixer.Update();
+			this_thread::sleep_for(chrono::milliseconds(PUMP_MS));
+		}
+		running = 0;
+		physics.join();
+		device.join();
+
+		printf("threads      %.1f s: %ld hits played, %d dropped, %d stolen, %d underruns in %ld device buffers\n",
+			   seconds, plays.load(), mixer.dropped.load(), mixer.stolen, mixer.underruns.load(), sink.frames / DEVICE);
+	}
+
+	return decoded ? 0 : 1;
+}
@@ -0,0 +1,193 @@
+//* bench_parallel.cpp *//
+
+//a crowded scene for World::Step() on a JobSystem (see Broadphase and
+//World::ResolveParallel()): lots of balls scattered over a big grid of random
+//tiles, each given a random push, bouncing off the tiles and each other and
+//breaking the tiles as they go (balls that fall out of the bottom are put back in).
+//
+//it plays the scene serially (no JobSystem), then again on 1, 2, 4.. threads,
+//up to one per core (or up to maxthreads), and reports the time per step, the speedup over the
+//serial run and how much work was stolen. every run has to end up exactly like
+//the serial one: the bodies, the tiles, and every event the listener was told,
+//in the same order.
+//
+//this is headless, so it doesn't need Qt; build it on its own with i.e
+//
+//	g++ -std=c++14 -O2 -pthread bench_parallel.cpp jobsystem.cpp world.cpp body.cpp bodyset.cpp broadphase.cpp replaylog.cpp tilegrid.cpp sparsetiles.cpp levelfile.cpp chunkstore.cpp -o bench_parallel
+//
+//and run it as "bench_parallel [balls] [steps] [maxthreads]" (20000 balls, 300
+//steps by default). more threads than cores won't be any faster, but they still
+//have to come out the same.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+
+#include "random.h"
+#include "tilegrid.h"
+#include "worldlistener.h"
+#include "body.h"
+#include "jobsystem.h"
+#include "world.h"
+
+using namespace std;
+
+const int CELLS = 200;//the grid is CELLS x CELLS tiles,
+const int TILE_XW = 20;//as big as the game's
+const int PER = 8;//about 1 cell in PER is a tile
+const int RADIUS = 8;
+const double SPEED = 3;//most a ball is pushed, per step
+
+static uint64_t Mix(uint64_t h, const uint64_t &v)
+{
+	h ^= v;
+	h *= 1099511628211ull;
+	return h;
+}
+
+//hashes everything the listener is told, in order
+class EventHash : public WorldListener
+{
+
+public:
+
+	uint64_t h;
+	long events;
+
+	EventHash() { h = 14695981039346656037ull; events = 0; }
+
+	void Add(const int &what, const int &a, const int &b, const int &c)
+	{
+		h = Mix(Mix(Mix(Mix(h, what), a), b), c);
+		events++;
+	}
+
+	void TileChanged(const TileRef &t) { Add(0, -1, t.i, t.j); }
+	void BodyCollided(Body *b, const TileRef &t) { Add(1, b->id, t.i, t.j); }
+	void BodyDied(Body *b) { Add(2, b->id, -1, -1); }
+	void BodiesCollided(const int &a, const int &b) { Add(3, a, b, -1); }
+};
+
+//the bytes of everything that moves or changes in w
+static uint64_t Hash(World &w)
+{
+	uint64_t h = 14695981039346656037ull;
+	const BodySet &b = w.bodies;
+	for( int k = 0; k < b.Count(); k++ )
+	{
+		const double v[4] = { b.x[k], b.y[k], b.ox[k], b.oy[k] };
+		const unsigned char *p = (const unsigned char*)v;
+		for( size_t n = 0; n < sizeof(v); n++ )
+			h = Mix(h, p[n]);
+	}
+	for( int k = 0; k < w.tiles->Count(); k++ )
+		h = Mix(Mix(Mix(h, w.tiles->id[k]), w.tiles->hp[k]), w.tiles->edges[k]);
+	return h;
+}
+
+//the same scene every time
+static void Setup(World &w, const string &level, const int &balls)
+{
+	w.tiles->Build();
+	w.Seed(1);
+	w.LoadLevel(level);
+	w.tiles->killY = (w.tiles->fullrows - 1) * w.tiles->th;
+
+	Random rng(2);
+	for( int k = 0; k < balls; k++ )
+	{
+		double x = TILE_XW*2 + rng.Next() % ((CELLS-2)*TILE_XW*2);
+		double y = TILE_XW*2 + rng.Next() % ((CELLS-2)*TILE_XW*2);
+		double vx = (rng.Next() % 1000 - 500) * SPEED / 500;
+		double vy = (rng.Next() % 1000 - 500) * SPEED / 500;
+		w.AddBody(Vector2(x, y), RADIUS);
+		w.PlaceBody(k, Vector2(x, y), Vector2(x - vx, y - vy));
+	}
+}
+
+//puts the balls that fell out back in, near the top
+static void Respawn(World &w, const long &step)
+{
+	for( int k = 0; k < w.bodies.Count(); k++ )
+	{
+		if( !w.bodies.IsDead(k) )
+			continue;
+		double x = TILE_XW*2 + (k*7919 + step) % ((CELLS-2)*TILE_XW*2);
+		double y = TILE_XW*3;
+		w.PlaceBody(k, Vector2(x, y), Vector2(x, y - 1));
+	}
+}
+
+int main(int argc, char **argv)
+{
+	int balls = (argc > 1) ? atoi(argv[1]) : 20000;
+	long steps = (argc > 2) ? atol(argv[2]) : 300;
+
+	string level(CELLS*CELLS, (char)(TID_EMPTY + CHAR_PAD));
+	Random rng(1);
+	for( int k = 0; k < CELLS*CELLS; k++ )
+	{
+		if( rng.Next() % PER == 0 )
+			level[k] = (char)(1 + rng.Next() % (TID_COUNT-1) + CHAR_PAD);
+	}
+
+	int cores = (argc > 3) ? atoi(argv[3]) : (int)thread::hardware_concurrency();
+	if( cores <= 0 )
+		cores = 1;
+
+	printf("%d balls, %dx%d tiles, %ld steps\n\n", balls, CELLS, CELLS, steps);
+	printf("%8s %10s %8s %8s %8s\n", "threads", "ms/step", "speedup", "stolen", "same");
+
+	uint64_t serialstate = 0, serialevents = 0;
+	double serialms = 0;
+	for( int t = 0; ; t = (t == 0) ? 1 : t*2 )
+	{
+		if( t > cores )
+			t = cores;
+
+		World w(CELLS, CELLS, TILE_XW, TILE_XW);
+		Setup(w, level, balls);
+		EventHash events;
+		w.SetListener(&events);
+
+		JobSystem *jobs = (t == 0) ? NULL : new JobSystem(t);
+		w.jobs = jobs;
+
+		chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+		for( long s = 0; s < steps; s++ )
+		{
+			w.Step();
+			Respawn(w, s);
+		}
+		double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count() / steps;
+
+		long stolen = 0;
+		for( int n = 0; jobs != NULL && n < jobs->Threads(); n++ )
+			stolen += jobs->workers[n]->stolen;
+
+		uint64_t state = Hash(w);
+		if( t == 0 )
+		{
+			serialstate = state;
+			serialevents = events.h;
+			serialms = ms;
+		}
+		int same = (state == serialstate && events.h == serialevents);
+
+		char name[16];
+		snprintf(name, sizeof(name), t ? "%d" : "serial", t);
+		printf("%8s %10.3f %7.2fx %8ld %8s\n", name, ms, serialms / ms, stolen, same ? "yes" : "NO");
+		fflush(stdout);
+
+		delete jobs;
+		if( t == cores )
+			break;
+	}
+
+	return 0;
+}
@@ -0,0 +1,304 @@
+//* bench_precision.cpp *//
+
+//how much is lost by running a World in float (World::single) or fixed point
+//(World::fixed) instead of double, and what it costs or saves. every stage is
+//played from a res x res sample of the starts NextStage() can pick (see
+//clearability.cpp), with the pad flown by BatchRunner's autopilot, once in each
+//precision, and it reports:
+//
+//	throughput: steps per second for each precision, playing the same games
+//	            one after another
+//
+//	divergence: float and fixed each played side by side with double, step for
+//	            step, from the same start: how far apart the balls got, how soon
+//	            they were more than a pixel (and a whole tile) apart, and how many
+//	            games ended differently (another outcome, or another number of
+//	            tiles broken)
+//
+//	checksum:   a hash of where every fixed game's ball was at every step. it
+//	            should be the same whatever machine, compiler or flags this was
+//	            built with (i.e -O0, or -O3 -ffast-math -mfma); the double one
+//	            is printed too, for comparison
+//
+//every game is played in a real World, a step at a time; each is also checked
+//against BatchRunner::Play() in the same precision, to make sure these are the
+//same games the rest of the tools play.
+//
+//this is headless, so it doesn't need Qt; build it on its own with i.e
+//
+//	g++ -std=c++14 -O2 -pthread bench_precision.cpp batchrunner.cpp world.cpp jobsystem.cpp body.cpp bodyset.cpp broadphase.cpp replaylog.cpp tilegrid.cpp sparsetiles.cpp levelfile.cpp chunkstore.cpp -o bench_precision
+//
+//and run it as "bench_precision [res] [steps]" (8x8 starts, 100000 steps; games
+//that go 100000 steps without breaking a tile are called off, as in clearability).
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <chrono>
+
+#include "vector2.h"
+#include "tilegrid.h"
+#include "world.h"
+#include "worldlistener.h"
+#include "levels.h"
+#include "batchrunner.h"
+
+using namespace std;
+
+const long IDLE = 100000;//steps without a tile broken before a game is called off
+
+enum PRECISION {
+	PREC_DOUBLE = 0,
+	PREC_FLOAT = 1,//World::single
+	PREC_FIXED = 2,//World::fixed
+	PREC_COUNT = 3
+};
+
+const char *PREC_NAME[PREC_COUNT] = { "double", "float", "fixed" };
+
+//one game with a single ball, in a World of its own set up and flown the way
+//BatchRunner::Play() does it, stepped one step at a time so it can be watched
+class Rollout : public WorldListener
+{
+
+public:
+
+	World world;
+	int ball;//its index in world.bodies
+
+	long steps;
+	long broke;//step a tile was last broken at
+	int tiles0;//breakable tiles the level started with,
+	int cleared;//and how many have been broken
+	int died;
+	vector< unsigned char > was;//ID of each cell before it was last hit
+
+	Rollout(const string &level, const unsigned int &seed, const double &x, const double &y, const int &precision)
+		: world(8, 8, TILERAD, TILERAD)
+	{
+		world.tiles->Build();
+		world.Seed(seed);
+		world.fixed = (precision == PREC_FIXED);
+		world.single = (precision == PREC_FLOAT);
+
+		ball = world.AddBody( Vector2(START_X, START_Y), OBJRAD );
+		world.PlaceBody( ball, Vector2(x, y), Vector2(START_X, START_Y) );
+		world.LoadLevel(level);
+
+		world.padx = PAD_X;
+		world.pady = PAD_Y;
+		world.padw = PAD_W;
+
+		steps = broke = 0;
+		tiles0 = cleared = died = 0;
+		const TileGrid &tiles = *world.tiles;
+		was.assign(tiles.Count(), TID_EMPTY);
+		for( int k = 0; k < tiles.Count(); k++ )
+		{
+			was[k] = tiles.id[k];
+			if( tiles.id[k] != TID_EMPTY && !(tiles.mat[k] & MAT_UNBREAKABLE) )
+				tiles0++;
+		}
+		world.SetListener(this);
+	}
+
+	int Over() const { return died || cleared >= tiles0 || IDLE <= steps - broke; }
+
+	int Outcome() const { return died ? GAME_DIED : (cleared >= tiles0) ? GAME_CLEARED : GAME_TIMEOUT; }
+
+	double X() const { return world.bodies.x[ball]; }
+	double Y() const { return world.bodies.y[ball]; }
+
+	void Step()
+	{
+		world.padx = BatchRunner::Autopilot(world.padx, world.padw, X(), PAD_STEP);
+		world.Step();
+		steps++;
+	}
+
+	//the tile has already taken the hit, so what it was is looked up in was
+	void BodyCollided(Body * /* b */, const TileRef &t)
+	{
+		if( t.IsNull() )
+			return;
+		unsigned char &ID = was[t.k];
+		if( ID != TID_EMPTY && t.ID() == TID_EMPTY )
+		{
+			cleared++;
+			broke = steps + 1;//(Step() hasn't counted this one yet)
+		}
+		ID = t.ID();
+	}
+
+	void BodyDied(Body * /* b */) { died = 1; }
+
+};
+
+//one start
+struct Start
+{
+	int stage;
+	double x, y;
+};
+
+//folds v into the FNV-1a hash h
+static void Hash(uint64_t &h, const double &v)
+{
+	unsigned char b[sizeof(v)];
+	memcpy(b, &v, sizeof(v));
+	for( size_t n = 0; n < sizeof(v); n++ )
+	{
+		h ^= b[n];
+		h *= 1099511628211ULL;
+	}
+}
+
+//plays every start to the end in the given PRECISION; returns the steps played,
+//and the checksum of where the balls were in sum
+static long PlayAll(const vector< Start > &starts, const long &steps, const int &precision, uint64_t &sum)
+{
+	long total = 0;
+	sum = 14695981039346656037ULL;
+	for( size_t g = 0; g < starts.size(); g++ )
+	{
+		Rollout game(MAPSTR[starts[g].stage], 1, starts[g].x, starts[g].y, precision);
+		while( !game.Over() && game.steps < steps )
+		{
+			game.Step();
+			Hash(sum, game.X());
+			Hash(sum, game.Y());
+		}
+		total += game.steps;
+	}
+	return total;
+}
+
+//how far a precision strays from double
+struct Divergence
+{
+	long apart1, apartTile;//games that got a pixel (a tile) apart,
+	double firstApart;//and when they first did, on average
+	double worst;//furthest apart any two balls were
+	int outcomes, clears;//games that ended differently
+	int real;//games that came out the same as BatchRunner::Play() in that precision,
+	int realDouble;//and in double
+};
+
+//plays every start in double and in the given PRECISION side by side
+static Divergence Diverge(const vector< Start > &starts, const long &steps, const int &precision)
+{
+	Divergence v;
+	v.apart1 = v.apartTile = 0;
+	v.firstApart = v.worst = 0;
+	v.outcomes = v.clears = v.real = v.realDouble = 0;
+	for( size_t g = 0; g < starts.size(); g++ )
+	{
+		Rollout d(MAPSTR[starts[g].stage], 1, starts[g].x, starts[g].y, PREC_DOUBLE);
+		Rollout f(MAPSTR[starts[g].stage], 1, starts[g].x, starts[g].y, precision);
+		long at1 = -1, atTile = -1;
+		while( (!d.Over() && d.steps < steps) || (!f.Over() && f.steps < steps) )
+		{
+			if( !d.Over() && d.steps < steps ) d.Step();
+			if( !f.Over() && f.steps < steps ) f.Step();
+
+			if( d.died || f.died )
+				continue;
+			double dx = d.X() - f.X();
+			double dy = d.Y() - f.Y();
+			double apart = sqrt(dx*dx + dy*dy);
+			if( v.worst < apart ) v.worst = apart;
+			if( at1 < 0 && 1 <= apart ) at1 = d.steps;
+			if( atTile < 0 && TILERAD*2 <= apart ) atTile = d.steps;
+		}
+		if( 0 <= at1 ) { v.apart1++; v.firstApart += at1; }
+		if( 0 <= atTile ) v.apartTile++;
+		if( d.Outcome() != f.Outcome() ) v.outcomes++;
+		if( d.cleared != f.cleared ) v.clears++;
+
+		BatchGame bg;
+		bg.level = MAPSTR[starts[g].stage];
+		bg.seed = 1;
+		bg.x = starts[g].x;
+		bg.y = starts[g].y;
+		bg.padspeed = PAD_STEP;
+		bg.swept = 0;
+		bg.steps = steps;
+		bg.idle = IDLE;
+		BatchResult br;
+		bg.fixed = (precision == PREC_FIXED);
+		bg.single = (precision == PREC_FLOAT);
+		BatchRunner::Play(bg, br);
+		if( br.outcome == f.Outcome() && br.steps == f.steps && br.cleared == f.cleared )
+			v.real++;
+		bg.fixed = bg.single = 0;
+		BatchRunner::Play(bg, br);
+		if( br.outcome == d.Outcome() && br.steps == d.steps && br.cleared == d.cleared )
+			v.realDouble++;
+	}
+	if( v.apart1 )
+		v.firstApart /= v.apart1;
+	return v;
+}
+
+int main(int argc, char **argv)
+{
+	int res = (argc > 1) ? atoi(argv[1]) : 8;
+	long steps = (argc > 2) ? atol(argv[2]) : 100000;
+	if( res < 1 )
+		res = 1;
+
+	vector< Start > starts;
+	for( int stage = 1; stage < STAGES; stage++ )
+	{
+		for( int j = 0; j < res; j++ )
+		{
+			for( int i = 0; i < res; i++ )
+			{
+				Start s;
+				s.stage = stage;
+				s.x = START_X + ((i*100)/res - 50) / 250.0;
+				s.y = START_Y + ((j*100)/res - 50) / 250.0;
+				starts.push_back(s);
+			}
+		}
+	}
+	printf("%d games (%dx%d starts on each of %d stages), up to %ld steps\n\n", (int)starts.size(), res, res, STAGES-1, steps);
+
+	//throughput
+	double rate[PREC_COUNT];
+	uint64_t sum[PREC_COUNT] = { 0 };
+	for( int p = 0; p < PREC_COUNT; p++ )
+	{
+		chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+		long played = PlayAll(starts, steps, p, sum[p]);
+		double s = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+		rate[p] = played / s;
+		printf("%-7s %12ld steps in %7.3f s: %6.2f M steps/s, %.2fx double\n", PREC_NAME[p], played, s, rate[p] / 1e6, rate[p] / rate[0]);
+	}
+	printf("\nfixed checksum:  %016llx\n", (unsigned long long)sum[PREC_FIXED]);
+	printf("double checksum: %016llx\n\n", (unsigned long long)sum[PREC_DOUBLE]);
+
+	//divergence
+	Divergence v[PREC_COUNT];
+	v[PREC_FLOAT] = Diverge(starts, steps, PREC_FLOAT);
+	v[PREC_FIXED] = Diverge(starts, steps, PREC_FIXED);
+
+	int n = (int)starts.size();
+	printf("%-24s %10s %10s\n", "", PREC_NAME[PREC_FLOAT], PREC_NAME[PREC_FIXED]);
+	printf("%-24s %10ld %10ld\n", "balls a pixel apart:", v[PREC_FLOAT].apart1, v[PREC_FIXED].apart1);
+	printf("%-24s %10.0f %10.0f\n", "  after steps (average):", v[PREC_FLOAT].firstApart, v[PREC_FIXED].firstApart);
+	printf("%-24s %10ld %10ld\n", "balls a tile apart:", v[PREC_FLOAT].apartTile, v[PREC_FIXED].apartTile);
+	printf("%-24s %10.2f %10.2f\n", "furthest apart (px):", v[PREC_FLOAT].worst, v[PREC_FIXED].worst);
+	printf("%-24s %10d %10d\n", "different outcome:", v[PREC_FLOAT].outcomes, v[PREC_FIXED].outcomes);
+	printf("%-24s %10d %10d\n", "different tiles broken:", v[PREC_FLOAT].clears, v[PREC_FIXED].clears);
+	printf("(of %d games)\n\n", n);
+	printf("double same as BatchRunner::Play(): %5d of %d games\n", v[PREC_FIXED].realDouble, n);
+	printf("float same as BatchRunner::Play():  %5d of %d games\n", v[PREC_FLOAT].real, n);
+	printf("fixed same as BatchRunner::Play():  %5d of %d games\n", v[PREC_FIXED].real, n);
+
+	return 0;
+}
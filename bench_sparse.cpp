@@ -0,0 +1,154 @@
+//* bench_sparse.cpp *//
+
+//compares a dense TileGrid (Build()) with a sparse one (BuildSparse(), see
+//sparsetiles.h) on mostly-empty levels, from 256x256 up to 4096x4096 cells and
+//from 1 in 1000 cells up to 1 in 10 being a tile. both grids load the same
+//level, then have the same random tiles broken and placed one at a time, and
+//every cell has to read the same from both afterwards (and so does the level
+//file the sparse grid writes). it reports how much memory each grid's planes
+//take, and how long loading, and reading every cell through Index() (scan), took.
+//
+//this is headless, so it doesn't need Qt; build it on its own with i.e
+//
+//	g++ -std=c++14 -O2 bench_sparse.cpp tilegrid.cpp sparsetiles.cpp levelfile.cpp -o bench_sparse
+//
+//and run it as "bench_sparse [maxsize]" (maxsize defaults to 4096).
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <chrono>
+
+#include "tilegrid.h"
+#include "levelfile.h"
+
+using namespace std;
+
+const int EDITS = 10000;//tiles broken/placed after loading
+
+//a level where about 1 cell in every per is a tile, of any shape
+static string RandomLevel(const int &rows, const int &cols, const int &per)
+{
+	string level(rows*cols, (char)(TID_EMPTY + CHAR_PAD));
+	for( int k = 0; k < rows*cols; k++ )
+	{
+		if( rand() % per == 0 )
+			level[k] = (char)(1 + rand() % (TID_COUNT-1) + CHAR_PAD);
+	}
+	return level;
+}
+
+//every cell of a and b reads the same, as far as the game can tell
+static int Same(const TileGrid &a, const TileGrid &b)
+{
+	if( a.fullrows != b.fullrows || a.fullcols != b.fullcols )
+		return 0;
+
+	for( int j = 0; j < a.fullrows; j++ )
+	{
+		for( int i = 0; i < a.fullcols; i++ )
+		{
+			int ka = a.Index(i, j);
+			int kb = b.Index(i, j);
+			if( a.id[ka] != b.id[kb] || a.ctype[ka] != b.ctype[kb] || a.signs[ka] != b.signs[kb] || a.edges[ka] != b.edges[kb] )
+				return 0;
+
+			//a dense grid leaves the old HP and color in a cleared cell, where a sparse
+			//one lets go of it; neither means anything until a tile is put back there
+			int color = (a.id[ka] == TID_EMPTY) ? MAT_COLOR : 0;
+			if( (a.id[ka] != TID_EMPTY && a.hp[ka] != b.hp[kb]) || (a.mat[ka] & ~color) != (b.mat[kb] & ~color) )
+				return 0;
+		}
+	}
+	return 1;
+}
+
+//reads the ID of every cell, the way a sweep over the whole grid would
+static long Scan(const TileGrid &g)
+{
+	long sum = 0;
+	for( int j = 0; j < g.fullrows; j++ )
+	{
+		for( int i = 0; i < g.fullcols; i++ )
+			sum += g.id[ g.Index(i, j) ];
+	}
+	return sum;
+}
+
+//breaks or places the same random tiles in both grids
+static void Edit(TileGrid &a, TileGrid &b, const int &n)
+{
+	for( int e = 0; e < EDITS; e++ )
+	{
+		int i = rand() % n;
+		int j = rand() % n;
+		char ch = (char)(((rand() % 4 == 0) ? 1 + rand() % (TID_COUNT-1) : TID_EMPTY) + CHAR_PAD);
+		a.SetTileState(i, j, ch);
+		b.SetTileState(i, j, ch);
+	}
+}
+
+static double Millis(chrono::steady_clock::time_point t0, chrono::steady_clock::time_point t1)
+{
+	return chrono::duration<double, milli>(t1 - t0).count();
+}
+
+int main(int argc, char **argv)
+{
+	int maxsize = (argc > 1) ? atoi(argv[1]) : 4096;
+	const int pers[] = { 1000, 100, 10 };
+	const char *filename = "bench_sparse.lvl";
+
+	printf("%10s %8s %12s %12s %8s %10s %10s %10s %10s %6s\n", "size", "tiles", "dense KB", "sparse KB", "ratio",
+		   "dense ms", "sparse ms", "d. scan", "s. scan", "same");
+
+	for( int n = 256; n <= maxsize; n *= 2 )
+	{
+		for( int p = 0; p < 3; p++ )
+		{
+			srand(n + pers[p]);
+			string level = RandomLevel(n, n, pers[p]);
+
+			TileGrid a(n, n, 10, 10);
+			TileGrid b(n, n, 10, 10);
+
+			a.rng.Seed(1);
+			a.Build();
+			chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+			a.SetTileStates(level);
+			chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+
+			b.rng.Seed(1);
+			b.BuildSparse();
+			chrono::steady_clock::time_point t2 = chrono::steady_clock::now();
+			b.SetTileStates(level);
+			chrono::steady_clock::time_point t3 = chrono::steady_clock::now();
+
+			long sa = Scan(a);
+			chrono::steady_clock::time_point t4 = chrono::steady_clock::now();
+			long sb = Scan(b);
+			chrono::steady_clock::time_point t5 = chrono::steady_clock::now();
+
+			int same = (sa == sb) && Same(a, b);
+			double da = a.Bytes() / 1024.0;
+			double db = b.Bytes() / 1024.0;
+
+			Edit(a, b, n);
+			same = same && Same(a, b);
+
+			//the sparse grid's level file has to map back to the same grid
+			TileGrid c(1, 1, 10, 10);
+			same = same && b.SaveLevelFile(filename) && c.LoadLevelFile(filename) && Same(a, c);
+
+			char tiles[16];
+			snprintf(tiles, sizeof(tiles), "1/%d", pers[p]);
+			printf("%5dx%-4d %8s %12.1f %12.1f %7.1fx %10.3f %10.3f %10.3f %10.3f %6s\n", n, n, tiles, da, db, (db > 0) ? da/db : 0.0,
+				   Millis(t0, t1), Millis(t2, t3), Millis(t3, t4), Millis(t4, t5), same ? "yes" : "NO");
+			fflush(stdout);
+		}
+	}
+
+	remove(filename);
+	return 0;
+}
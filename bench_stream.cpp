@@ -0,0 +1,265 @@
+//* bench_stream.cpp *//
+
+//streams a World through a tile world far bigger than its window (see
+//ChunkStore): it makes a random world of chunks x chunks chunks on disk, drops
+//a few balls in the middle and keeps kicking them towards a random chunk, and
+//towards each other, so they wander across the world together; once they get
+//there, another chunk is picked. it reports the time per step, how often the
+//window slid, the cache's hits and misses, and how much memory the tiles took
+//next to the size of the whole world.
+//
+//with -check it also keeps the whole world in one ordinary TileGrid, and makes
+//every tile change the balls cause there too; each time the window slides, the
+//window has to match that grid exactly (edges included, except on its outer
+//ring), which checks the paging, the write-back and the stitching of the seams.
+//
+//this is headless, so it doesn't need Qt; build it on its own with i.e
+//
+//	g++ -std=c++14 -O2 -pthread bench_stream.cpp chunkstore.cpp levelfile.cpp world.cpp jobsystem.cpp replaylog.cpp body.cpp bodyset.cpp broadphase.cpp tilegrid.cpp sparsetiles.cpp -o bench_stream
+//
+//and run it as "bench_stream [-check] [chunks] [steps]" (64 chunks, i.e 2048x2048
+//tiles, and 200000 steps by default; with -check, 15 chunks).
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <chrono>
+
+#include "tilegrid.h"
+#include "chunkstore.h"
+#include "worldlistener.h"
+#include "world.h"
+
+using namespace std;
+
+const int TILE_XW = 20;//as in the game
+const int RADIUS = 10;
+const int BALLS = 16;
+const int KICK = 16;//steps between kicks
+const double SPEED = 9;
+const double PULL = 0.02;//of the distance to the middle of the balls, per kick
+const int CAPACITY = 32;//chunk slots in the cache
+
+//about 1 cell in 16 is a tile, of any shape
+static int RandomTile(const int &gi, const int &gj, void * /* ctx */)
+{
+	unsigned int h = (unsigned int)gi * 73856093u ^ (unsigned int)gj * 19349663u;
+	h ^= h >> 13;
+	h *= 0x5bd1e995u;
+	h ^= h >> 15;
+	if( (h & 15) != 0 )
+		return TID_EMPTY;
+	return 1 + (h >> 4) % (TID_COUNT-1);
+}
+
+//copies every tile change in the streamed window into the whole-world grid
+class Shadow : public WorldListener
+{
+
+public:
+
+	World *w;
+	ChunkStore *store;
+	TileGrid *grid;
+
+	void TileChanged(const TileRef &t)
+	{
+		int k = grid->Index(t.i + store->oci*CHUNK, t.j + store->ocj*CHUNK);
+		grid->id[k] = t.ID();
+		grid->hp[k] = t.HP();
+		grid->mat[k] = w->tiles->mat[t.k];
+		grid->UpdateType(k);
+		grid->UpdateEdges(k);
+		grid->UpdateNeighbors(k);
+	}
+	void MapChanged(TileGrid * /* g */) { }
+	void BodyCollided(Body * /* b */, const TileRef & /* t */) { }
+	void BodyDied(Body * /* b */) { }
+	void BodiesCollided(const int & /* a */, const int & /* b */) { }
+
+};
+
+//the window has the same tiles as the matching part of grid
+static int Same(const TileGrid &win, const ChunkStore &store, const TileGrid &grid)
+{
+	for( int j = 0; j < win.fullrows; j++ )
+	{
+		for( int i = 0; i < win.fullcols; i++ )
+		{
+			int k = win.Index(i, j);
+			int g = grid.Index(i + store.oci*CHUNK, j + store.ocj*CHUNK);
+			int ring = (i == 0 || j == 0 || i == win.fullcols-1 || j == win.fullrows-1);
+
+			if( win.id[k] != grid.id[g] || win.ctype[k] != grid.ctype[g] || win.signs[k] != grid.signs[g] ||
+				win.hp[k] != grid.hp[g] || win.mat[k] != grid.mat[g] || (!ring && win.edges[k] != grid.edges[g]) )
+			{
+				return 0;
+			}
+		}
+	}
+	return 1;
+}
+
+int main(int argc, char **argv)
+{
+	int check = 0;
+	int chunks = 0;
+	long steps = 200000;
+	for( int a = 1, n = 0; a < argc; a++ )
+	{
+		if( strcmp(argv[a], "-check") == 0 )
+			check = 1;
+		else if( n++ == 0 )
+			chunks = atoi(argv[a]);
+		else
+			steps = atol(argv[a]);
+	}
+	if( chunks <= 0 )
+		chunks = check ? 15 : 64;
+	if( check && chunks % 2 == 0 )
+		chunks++;//the whole-world grid is a window with the world in it, so it needs a middle chunk
+
+	const char *filename = "bench_stream.wld";
+
+	chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+	if( !ChunkStore::Create(filename, chunks, chunks, TILE_XW, TILE_XW, RandomTile, NULL, 1) )
+	{
+		printf("can't write %s\n", filename);
+		return 1;
+	}
+	chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+
+	TileGrid grid(1, 1, TILE_XW, TILE_XW);
+	if( check )
+	{
+		ChunkStore all;
+		all.Open(filename, chunks/2, 0);
+		all.Attach(&grid, chunks/2, chunks/2);
+		all.Close();
+	}
+
+	ChunkStore store;
+	if( !store.Open(filename, 1, CAPACITY) )
+	{
+		printf("can't read %s\n", filename);
+		return 1;
+	}
+
+	World w(1, 1, TILE_XW, TILE_XW);
+	w.Seed(1);
+	w.swept = 1;
+	w.Stream(&store, chunks/2, chunks/2);
+
+	Shadow shadow;
+	shadow.w = &w;
+	shadow.store = &store;
+	shadow.grid = &grid;
+	if( check )
+		w.SetListener(&shadow);
+
+	//start in the middle of the middle chunk, on a clear cell
+	double cx = (store.span/2)*CHUNK*w.tiles->tw + CHUNK*TILE_XW;
+	double cy = (store.span/2)*CHUNK*w.tiles->th + CHUNK*TILE_XW;
+	for( int b = 0; b < BALLS; b++ )
+	{
+		double x = cx + (b % 4)*4*TILE_XW;
+		double y = cy + (b / 4)*4*TILE_XW;
+		w.tiles->Clear( w.tiles->GetTile_S(x, y).k );
+		w.AddBody(Vector2(x, y), RADIUS);
+	}
+
+	double cw = CHUNK*w.tiles->tw;//size of a chunk, in pixels
+	double ch = CHUNK*w.tiles->th;
+	double tx = 0, ty = 0;//where the balls are headed, in the world
+	int targets = 0;
+
+	int slides = store.slides;
+	int bad = 0;
+	int ci0 = store.oci, cj0 = store.ocj, farthest = 0;
+
+	chrono::steady_clock::time_point t2 = chrono::steady_clock::now();
+	long s = 0;
+	for( ; s < steps && !bad; s++ )
+	{
+		if( s % KICK == 0 )
+		{
+			double mx = 0, my = 0;
+			int live = 0;
+			for( int b = 0; b < w.bodies.Count(); b++ )
+			{
+				if( w.bodies.IsDead(b) )
+					continue;
+				mx += w.bodies.x[b];
+				my += w.bodies.y[b];
+				live++;
+			}
+			if( live == 0 )
+				break;//they all strayed off the window
+			mx /= live;
+			my /= live;
+
+			//head for another chunk, away from the edges of the world, once they're there
+			double gx = mx + store.oci*cw;
+			double gy = my + store.ocj*ch;
+			if( targets == 0 || fabs(tx - gx) + fabs(ty - gy) < cw )
+			{
+				tx = (1 + w.rng.Next() % (chunks-2) + 0.5)*cw;
+				ty = (1 + w.rng.Next() % (chunks-2) + 0.5)*ch;
+				targets++;
+			}
+			Vector2 d(tx - gx, ty - gy);
+			d.mult(1 / d.len());
+
+			for( int b = 0; b < w.bodies.Count(); b++ )
+			{
+				if( w.bodies.IsDead(b) )
+					continue;
+				Vector2 pos(w.bodies.x[b], w.bodies.y[b]);
+				Vector2 pull((mx - pos.x)*PULL, (my - pos.y)*PULL);
+				double len = pull.len();
+				if( SPEED < len )
+					pull.mult(SPEED / len);
+				Vector2 vel(SPEED*d.x + pull.x + (w.rng.Next() % 5 - 2)*0.25, SPEED*d.y + pull.y + (w.rng.Next() % 5 - 2)*0.25);
+				w.PlaceBody(b, pos, pos.minus(vel));
+			}
+		}
+
+		w.Step();
+
+		if( store.slides != slides )
+		{
+			slides = store.slides;
+			if( check && !Same(*w.tiles, store, grid) )
+			{
+				printf("window differs from the whole world after slide %d, step %ld\n", slides, s);
+				bad = 1;
+			}
+
+			int dist = abs(store.oci - ci0) > abs(store.ocj - cj0) ? abs(store.oci - ci0) : abs(store.ocj - cj0);
+			if( farthest < dist )
+				farthest = dist;
+		}
+	}
+	chrono::steady_clock::time_point t3 = chrono::steady_clock::now();
+
+	int live = 0;
+	for( int b = 0; b < w.bodies.Count(); b++ )
+		live += !w.bodies.IsDead(b);
+
+	double worldmb = (double)chunks*chunks*CHUNK_BYTES / (1024.0*1024.0);
+	printf("world        %dx%d chunks (%dx%d tiles), %.1f MB on disk, made in %.1f ms\n", chunks, chunks, chunks*CHUNK, chunks*CHUNK, worldmb,
+		   chrono::duration<double, milli>(t1 - t0).count());
+	printf("resident     %.1f KB (%dx%d chunk window + %d cached chunks)\n", store.Resident()/1024.0, store.span, store.span, (int)store.cache.size());
+	printf("steps        %ld, %.1f ns/step\n", s, chrono::duration<double, nano>(t3 - t2).count() / (s ? s : 1));
+	printf("window       %d slides, got %d chunks from its start; %d chunks visited, %d of %d balls still in it\n", store.slides, farthest, targets-1, live, BALLS);
+	printf("cache        %d hits, %d misses, %d reads, %d writes\n", store.hits, store.misses, store.reads, store.writes);
+	if( check )
+		printf("check        %s\n", bad ? "FAILED" : "window matched the whole world at every slide");
+
+	w.SetListener(NULL);
+	store.Detach();
+	store.Close();
+	remove(filename);
+	return bad;
+}
@@ -0,0 +1,315 @@
+//* bench_vector.cpp *//
+
+//a before/after benchmark for the header-only Vector2 and the Vector2x4/x8
+//batch types (vector2.h, vector2x.h), on the loop every collision ends in: the
+//contact response of Body::ReportCollisionVsWorld(), which pushes a body out
+//along the projection vector and bounces its velocity off the surface normal.
+//
+//the same contacts are resolved five ways:
+//
+//	outofline: with a copy of the old Vector2, whose methods were all out of line
+//	           in vector2.cpp (they're kept from inlining here, to match) and took
+//	           copies of their arguments
+//	vector2:   with the new Vector2's operators
+//	body:      through Body::ReportCollisionVsWorld() itself, one Body at a time
+//	x4, x8:    4 and 8 contacts at a time, with Vector2x4 and Vector2x8
+//
+//and every way has to give exactly the same positions as vector2.
+//
+//this is headless, so it doesn't need Qt; build it on its own with i.e
+//
+//	g++ -std=c++14 -O2 bench_vector.cpp body.cpp tilegrid.cpp sparsetiles.cpp levelfile.cpp -o bench_vector
+//
+//(add -mavx2 for the AVX2 batch types; SSE2 is the default on x86-64) and run
+//it as "bench_vector [contacts] [reps]" (4096 contacts, 2000 reps by default).
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include <chrono>
+#include <type_traits>
+
+#include "body.h"
+#include "tilegrid.h"
+#include "vector2.h"
+#include "vector2x.h"
+
+using namespace std;
+
+static_assert( std::is_trivially_copyable< Vector2 >::value, "Vector2 should be trivially copyable" );
+static_assert( Vector2(1, 2).dot( Vector2(3, 4) ) == 11, "Vector2 should work at compile time" );
+static_assert( (Vector2(1, 2) + Vector2(3, 4)*2).y == 10, "Vector2 should work at compile time" );
+
+#if defined(__GNUC__)
+#define OUT_OF_LINE __attribute__((noinline))
+#else
+#define OUT_OF_LINE
+#endif
+
+//the old Vector2, as it was before it moved into its header
+class OldVector2
+{
+
+public:
+
+	double x,y;
+
+	OldVector2() { x = y = 0 ; }
+	OldVector2(const double &x_in, const double &y_in);
+	~OldVector2();
+
+	OldVector2 clone();
+	OldVector2 plus(const OldVector2 &v2);
+	OldVector2 minus(const OldVector2 &v2);
+	OldVector2 proj(OldVector2 v2);
+
+	double dot(const OldVector2 &v2);
+
+	void mult(const double &s);
+	void pluseq(const OldVector2 &v2);
+
+};
+
+OUT_OF_LINE OldVector2::OldVector2(const double &x_in, const double &y_in) { x = x_in; y = y_in; }
+OUT_OF_LINE OldVector2::~OldVector2() { }
+OUT_OF_LINE OldVector2 OldVector2::clone() { return OldVector2(x, y); }
+OUT_OF_LINE OldVector2 OldVector2::plus(const OldVector2 &v2) { return OldVector2( x + v2.x, y + v2.y ); }
+OUT_OF_LINE OldVector2 OldVector2::minus(const OldVector2 &v2) { return OldVector2( x - v2.x, y - v2.y ); }
+OUT_OF_LINE double OldVector2::dot(const OldVector2 &v2) { return (x * v2.x) + (y * v2.y); }
+OUT_OF_LINE void OldVector2::mult(const double &s) { x *= s; y *= s; }
+OUT_OF_LINE void OldVector2::pluseq(const OldVector2 &v2) { x += v2.x; y += v2.y; }
+
+//(n has unit length, so the projection's denominator is 1, but it's still divided by)
+OUT_OF_LINE OldVector2 OldVector2::proj(OldVector2 v2)
+{
+	double den = v2.dot(v2);
+	OldVector2 v;
+	if( den == 0 )
+		v = clone();
+	else
+	{
+		v = v2.clone();
+		v.mult( dot(v2) / den );
+	}
+	return v;
+}
+
+//the contacts, structure-of-arrays: where each body is and was, and the
+//projection vector and surface normal it was given
+class Contacts
+{
+
+public:
+
+	vector< double > x, y, ox, oy;
+	vector< double > px, py, nx, ny;
+
+	Contacts(const int &n)
+	{
+		x.resize(n); y.resize(n); ox.resize(n); oy.resize(n);
+		px.resize(n); py.resize(n); nx.resize(n); ny.resize(n);
+
+		srand(1);
+		for( int k = 0; k < n; k++ )
+		{
+			x[k] = rand() % 4000 / 10.0;
+			y[k] = rand() % 4000 / 10.0;
+			ox[k] = x[k] - (rand() % 200 - 100) / 50.0;
+			oy[k] = y[k] - (rand() % 200 - 100) / 50.0;
+
+			double a = rand() % 3600 * (M_PI / 1800);
+			double pen = rand() % 100 / 50.0;
+			nx[k] = cos(a);
+			ny[k] = sin(a);
+			px[k] = nx[k]*pen;
+			py[k] = ny[k]*pen;
+		}
+	}
+
+	int Count() const { return (int)x.size(); }
+
+	int Same(const Contacts &c) const
+	{
+		return x == c.x && y == c.y && ox == c.ox && oy == c.oy;
+	}
+
+};
+
+static void RespondOutOfLine(Contacts &c)
+{
+	for( int k = 0; k < c.Count(); k++ )
+	{
+		OldVector2 pos(c.x[k], c.y[k]);
+		OldVector2 oldpos(c.ox[k], c.oy[k]);
+		OldVector2 p(c.px[k], c.py[k]);
+		OldVector2 n(c.nx[k], c.ny[k]);
+
+		OldVector2 v = pos.minus(oldpos);
+		double dp = v.dot(n);
+		OldVector2 vn = n.clone();
+		vn.mult(dp);
+		OldVector2 vt = v.minus(vn);
+
+		OldVector2 b, f;
+		if( dp < 0 )
+		{
+			f = vt.clone();
+			f.mult(FRICTION);
+			b = vn.clone();
+			b.mult(1+BOUNCE);
+		}
+
+		pos.pluseq(p);
+		oldpos.pluseq( p.plus(b).plus(f) );
+
+		c.x[k] = pos.x; c.y[k] = pos.y;
+		c.ox[k] = oldpos.x; c.oy[k] = oldpos.y;
+	}
+}
+
+static void RespondVector2(Contacts &c)
+{
+	for( int k = 0; k < c.Count(); k++ )
+	{
+		Vector2 pos(c.x[k], c.y[k]);
+		Vector2 oldpos(c.ox[k], c.oy[k]);
+		Vector2 p(c.px[k], c.py[k]);
+		Vector2 n(c.nx[k], c.ny[k]);
+
+		Vector2 v = pos - oldpos;
+		double dp = v.dot(n);
+		Vector2 vn = n*dp;
+		Vector2 vt = v - vn;
+
+		Vector2 b, f;
+		if( dp < 0 )
+		{
+			f = vt*FRICTION;
+			b = vn*(1+BOUNCE);
+		}
+
+		pos += p;
+		oldpos += p + b + f;
+
+		c.x[k] = pos.x; c.y[k] = pos.y;
+		c.ox[k] = oldpos.x; c.oy[k] = oldpos.y;
+	}
+}
+
+static void RespondBody(Contacts &c, Body &body)
+{
+	for( int k = 0; k < c.Count(); k++ )
+	{
+		body.pos = Vector2(c.x[k], c.y[k]);
+		body.oldpos = Vector2(c.ox[k], c.oy[k]);
+		body.ReportCollisionVsWorld(c.px[k], c.py[k], c.nx[k], c.ny[k], TileRef());
+		c.x[k] = body.pos.x; c.y[k] = body.pos.y;
+		c.ox[k] = body.oldpos.x; c.oy[k] = body.oldpos.y;
+	}
+}
+
+//N contacts at a time; the rest go through RespondVector2()'s arithmetic
+template<class D, int N> static void RespondBatch(Contacts &c)
+{
+	typedef Vector2xN< D > V;
+	const D zero(0.0);
+	int k = 0;
+	for( ; k + N <= c.Count(); k += N )
+	{
+		V pos = V::Load(&c.x[k], &c.y[k]);
+		V oldpos = V::Load(&c.ox[k], &c.oy[k]);
+		V p = V::Load(&c.px[k], &c.py[k]);
+		V n = V::Load(&c.nx[k], &c.ny[k]);
+
+		V v = pos - oldpos;
+		D dp = v.dot(n);
+		V vn = n*dp;
+		V vt = v - vn;
+
+		//only where dp < 0
+		D into = Less(dp, zero);
+		V f = Select(into, vt*FRICTION, V(Vector2(0, 0)));
+		V b = Select(into, vn*(1+BOUNCE), V(Vector2(0, 0)));
+
+		pos += p;
+		oldpos += p + b + f;
+
+		pos.Store(&c.x[k], &c.y[k]);
+		oldpos.Store(&c.ox[k], &c.oy[k]);
+	}
+	for( ; k < c.Count(); k++ )
+	{
+		Vector2 pos(c.x[k], c.y[k]);
+		Vector2 oldpos(c.ox[k], c.oy[k]);
+		Vector2 p(c.px[k], c.py[k]);
+		Vector2 n(c.nx[k], c.ny[k]);
+
+		Vector2 v = pos - oldpos;
+		double dp = v.dot(n);
+		Vector2 vn = n*dp;
+		Vector2 vt = v - vn;
+
+		Vector2 b, f;
+		if( dp < 0 )
+		{
+			f = vt*FRICTION;
+			b = vn*(1+BOUNCE);
+		}
+
+		pos += p;
+		oldpos += p + b + f;
+
+		c.x[k] = pos.x; c.y[k] = pos.y;
+		c.ox[k] = oldpos.x; c.oy[k] = oldpos.y;
+	}
+}
+
+enum RESPOND {
+	RESPOND_OUTOFLINE = 0,
+	RESPOND_VECTOR2 = 1,
+	RESPOND_BODY = 2,
+	RESPOND_X4 = 3,
+	RESPOND_X8 = 4,
+	RESPOND_COUNT = 5
+};
+
+const char *RESPOND_NAME[RESPOND_COUNT] = { "outofline", "vector2", "body", "x4", "x8" };
+
+int main(int argc, char **argv)
+{
+	int contacts = (argc > 1) ? atoi(argv[1]) : 4096;
+	int reps = (argc > 2) ? atoi(argv[2]) : 2000;
+
+	Body body(Vector2(0, 0), 16);
+
+	printf("%d contacts, %d reps\n\n", contacts, reps);
+	printf("%10s %10s %8s %6s\n", "loop", "ns/contact", "speedup", "same");
+
+	Contacts want(contacts);
+	for( int r = 0; r < reps; r++ )
+		RespondVector2(want);
+
+	double base = 0;
+	for( int w = 0; w < RESPOND_COUNT; w++ )
+	{
+		Contacts c(contacts);
+		chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+		for( int r = 0; r < reps; r++ )
+		{
+			if( w == RESPOND_OUTOFLINE ) RespondOutOfLine(c);
+			else if( w == RESPOND_VECTOR2 ) RespondVector2(c);
+			else if( w == RESPOND_BODY ) RespondBody(c, body);
+			else if( w == RESPOND_X4 ) RespondBatch< Double4, 4 >(c);
+			else RespondBatch< Double8, 8 >(c);
+		}
+		double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - t0).count() / ((double)reps*contacts);
+		if( w == 0 )
+			base = ns;
+
+		printf("%10s %10.3f %7.2fx %6s\n", RESPOND_NAME[w], ns, base / ns, c.Same(want) ? "yes" : "NO");
+	}
+
+	return 0;
+}
@@ -0,0 +1,3058 @@
+
+/* body.cpp */
+
+//this is the headless half of the old Circle widget; it holds the circle's
+//physical state and all of the circle-vs-tile collision code, and knows
+//nothing about Qt. the Circle widget (circle.cpp) is now only a view of a Body.
+
+#include "tilegrid.h"
+#include "tileedges.h"
+#include "worldlistener.h"
+#include "collisionbuffer.h"
+#include "body.h"
+
+#include <cmath>
+#include <cstdlib>
+
+//the listener only knows about Body; a BodyF or a BodyFixed is told about as a
+//copy of itself in double, so it sees the same position, id and so on
+static void TellCollided(WorldListener *l, Body *b, const TileRef &t) { l->BodyCollided(b, t); }
+static void TellDied(WorldListener *l, Body *b) { l->BodyDied(b); }
+
+template<class T> static void TellCollided(WorldListener *l, BodyT<T> *b, const TileRef &t)
+{
+	Body d(*b);
+	l->BodyCollided(&d, t);
+}
+
+template<class T> static void TellDied(WorldListener *l, BodyT<T> *b)
+{
+	Body d(*b);
+	l->BodyDied(&d);
+}
+
+//the slope normal of t's tile, (sx,sy) in its TileShape, in T. BodyFixed uses
+//its own table, normalized with Fixed's integer sqrt, so no double math goes
+//into it.
+template<class T> static inline T SlopeX(const TileRef &t) { return (T)t.sx(); }
+template<class T> static inline T SlopeY(const TileRef &t) { return (T)t.sy(); }
+
+static const Vector2T< Fixed >* FixedSlopes()
+{
+	struct Table
+	{
+		Vector2T< Fixed > n[TID_COUNT];
+
+		Table()
+		{
+			const TileShape *shapes = TileShapes();
+			for( int ID = 0; ID < TID_COUNT; ID++ )
+			{
+				//the slopes' normals before they're normalized: (1,1), (1,2) or (2,1), signed
+				const TileShape &s = shapes[ID];
+				int dx = s.signx, dy = s.signy;
+				if( s.CTYPE == CTYPE_22DEGs || s.CTYPE == CTYPE_22DEGb )
+					dy *= 2;
+				else if( s.CTYPE == CTYPE_67DEGs || s.CTYPE == CTYPE_67DEGb )
+					dx *= 2;
+				else if( s.sx == 0 && s.sy == 0 )
+					dx = dy = 0;
+
+				Fixed len = sqrt( Fixed(dx*dx + dy*dy) );
+				n[ID] = (len == 0) ? Vector2T< Fixed >() : Vector2T< Fixed >( Fixed(dx) / len, Fixed(dy) / len );
+			}
+		}
+	};
+	static const Table table;
+	return table.n;
+}
+
+//the center of t's cell, in T; a BodyFixed gets it straight from the ints
+template<class T> static inline T CenterX(const TileRef &t) { return (T)t.x(); }
+template<class T> static inline T CenterY(const TileRef &t) { return (T)t.y(); }
+template<> inline Fixed CenterX<Fixed>(const TileRef &t) { return Fixed( t.map->xw + t.i*t.map->tw ); }
+template<> inline Fixed CenterY<Fixed>(const TileRef &t) { return Fixed( t.map->yw + t.j*t.map->th ); }
+
+template<> inline Fixed SlopeX<Fixed>(const TileRef &t) { return FixedSlopes()[ t.ID() ].x; }
+template<> inline Fixed SlopeY<Fixed>(const TileRef &t) { return FixedSlopes()[ t.ID() ].y; }
+
+template<class T>
+BodyT<T>::BodyT(const Vector2T< T > &pos_in, const int &r_in)
+{
+	//OTYPE = OTYPE_CIRCLE;
+        	
+	OTYPE = 1; 
+	
+	pos = pos_in;
+	oldpos = pos;
+	r = abs(r_in);
+	
+	dead = 0;
+	id = -1;
+	listener = NULL;
+	collisions = NULL;
+}
+
+/*------------ This has been substituted by the Circle view's PaintEvent.
+void Body::Draw(rend)
+{
+	//rend.DrawCircle(this.pos, this.r);
+}
+----------------------------------------------------------------*/
+
+
+//=====================================
+//simple physics functions
+
+//p is projection vector, n is surface normal, obj is other object.
+
+template<class T>
+void BodyT<T>::ReportCollisionVsWorld(const Vector2T< T > &p, const Vector2T< T > &n, const TileRef &obj)
+{
+
+	//collision reported to obj
+
+
+	//calc velocity
+	Vector2T< T > v = pos - oldpos;
+
+	//find component of velocity parallel to collision normal
+	T dp = v.dot(n);
+	Vector2T< T > vn = n*dp;//project velocity onto collision normal; this is normal velocity
+
+	Vector2T< T > vt = v - vn;//tangent velocity
+
+	//we only want to apply collision response forces if the object is travelling into, and not out of, the collision
+	Vector2T< T > b, f;
+	if(dp < 0)
+	{
+		f = vt*(T)FRICTION;
+
+		b = vn*(T)(1+BOUNCE);//this bounce constant should be elsewhere, i.e inside the object/tile/etc..
+	}
+	else
+	{
+		//moving out of collision, do not apply forces (b and f stay 0)
+	}
+
+
+	pos += p;//project object out of collision
+
+	oldpos += p + b + f;//apply bounce+friction impulses which alter velocity
+
+	if( collisions != NULL )
+	{
+		//the World does the rest once the step is done
+		collisions->Add( id, -1, obj.i, obj.j, (double)n.x, (double)n.y, (dp < 0) ? (double)( -dp*(T)(1+BOUNCE) ) : 0.0 );
+		return;
+	}
+
+	if( !obj.IsNull() )
+		obj.Hit();
+
+	if( listener != NULL )
+		TellCollided(listener, this, obj);
+}
+
+//marks the body dead, and records it (or tells the listener, as above); it's
+//left where it is
+template<class T>
+void BodyT<T>::Die()
+{
+	dead = 1;
+
+	if( collisions != NULL )
+	{
+		collisions->AddDeath( id );
+		return;
+	}
+
+	if( listener != NULL )
+		TellDied(listener, this);
+}
+
+
+template<class T>
+void BodyT<T>::IntegrateVerlet()
+{
+	T d = (T)DRAG;
+	T g = (T)GRAV;
+		
+	T ox = oldpos.x; //we can't swap buffers since mcs/sticks point directly to vector2s..
+	T oy = oldpos.y;
+	
+	T px,py;
+	
+	oldpos.x = px = pos.x;		//get vector values
+	oldpos.y = py = pos.y;		//p = position  
+					            //o = oldposition
+	//integrate	
+	Vector2T< T > step = Vector2T< T >(px, py)*d - Vector2T< T >(ox, oy)*d;
+	step.y += g;
+	pos += step;
+}
+
+
+
+//the cell the body's center is in; the same as TileGrid::GetTile_V(pos), but
+//worked out in T, so a BodyFixed doesn't need any double math to find it
+template<class T>
+TileRef BodyT<T>::Cell( TileGrid *tiles ) const
+{
+	return TileRef( tiles, (int)(pos.x / tiles->tw), (int)(pos.y / tiles->th) );
+}
+
+//(Fixed's / rounds, which could put a center a hair short of a cell edge into
+//the next cell; dividing the raw values truncates, as (int) on a double does)
+template<>
+TileRef BodyT<Fixed>::Cell( TileGrid *tiles ) const
+{
+	return TileRef( tiles, (int)(pos.x.raw / (tiles->tw * Fixed::ONE)), (int)(pos.y.raw / (tiles->th * Fixed::ONE)) );
+}
+
+
+//================================ swept collision ============================
+//
+//CollideCirclevsTileMap() only looks at where the circle ends up; if it moves
+//far enough in one step it can skip over a thin tile (i.e a HALF) or a corner.
+//
+//the swept test follows the circle along its motion this step (oldpos->pos),
+//finds the first time it touches the boundary of a solid cell, and backs the
+//circle up to that point so the regular (discrete) test resolves the contact
+//there. then the circle moves on with whatever velocity it has left, for the
+//rest of the step, and the sweep is repeated (up to SWEEP_MAX contacts).
+//
+//the sweep is against the bounding box of the solid part of each cell: the whole
+//cell, or half of it for HALF tiles. for slopes and curves this is conservative;
+//if the discrete test finds nothing at the contact point, the circle just
+//carries on along the same path.
+
+//time in [0,1] at which a circle moving from a by d gets within rad of the segment
+//at x = fx (vertical face, y in [y0,y1]) whose outside is in direction nx; 2 if never.
+//faces the circle already touches at a (closer than r) are the discrete test's job.
+template<class T>
+static T SweepFaceX(const T &fx, const T &y0, const T &y1, const int &nx,
+						 const Vector2T< T > &a, const Vector2T< T > &d, const T &r, const T &rad)
+{
+	T dist = (a.x - fx)*nx;//distance from the face, on its outside
+	T vel = d.x*nx;
+	if( dist < r || 0 <= vel )
+		return 2;
+
+	T t = (rad - dist) / vel;
+	T y = a.y + t*d.y;
+	if( 1 < t || y < y0 || y1 < y )
+		return 2;
+	return t;
+}
+
+//the same for a horizontal face at y = fy, x in [x0,x1], outside in direction ny
+template<class T>
+static T SweepFaceY(const T &fy, const T &x0, const T &x1, const int &ny,
+						 const Vector2T< T > &a, const Vector2T< T > &d, const T &r, const T &rad)
+{
+	T dist = (a.y - fy)*ny;
+	T vel = d.y*ny;
+	if( dist < r || 0 <= vel )
+		return 2;
+
+	T t = (rad - dist) / vel;
+	T x = a.x + t*d.x;
+	if( 1 < t || x < x0 || x1 < x )
+		return 2;
+	return t;
+}
+
+//time at which a circle moving from a by d gets within rad of the vertex (vx,vy); 2 if never
+template<class T>
+static T SweepVertex(const T &vx, const T &vy, const Vector2T< T > &a, const Vector2T< T > &d, const T &r, const T &rad)
+{
+	T ex = a.x - vx;//vertex->circle vector
+	T ey = a.y - vy;
+	T c = ex*ex + ey*ey;
+	if( c < r*r )
+		return 2;
+
+	T qa = d.x*d.x + d.y*d.y;
+	T qb = ex*d.x + ey*d.y;//(half of the linear term)
+	if( qa == 0 || 0 <= qb )
+		return 2;//not moving, or moving away
+
+	T disc = qb*qb - qa*(c - rad*rad);
+	if( disc < 0 )
+		return 2;
+
+	T t = (-qb - sqrt(disc)) / qa;
+	if( t < 0 || 1 < t )
+		return 2;
+	return t;
+}
+
+//sweeps this circle from "from" to "to" against the solid cells of tiles;
+//returns the fraction of the way at which it first touches one, or 2 if it doesn't.
+template<class T>
+T BodyT<T>::SweepTimeOfImpact( TileGrid *tiles, const Vector2T< T > &from, const Vector2T< T > &to )
+{
+	Vector2T< T > d = to - from;
+	T rad = r - (T)SWEEP_SKIN;
+
+	//only cells the swept circle can overlap
+	int i0 = (int)floor( ((from.x < to.x ? from.x : to.x) - r) / tiles->tw );
+	int i1 = (int)floor( ((from.x < to.x ? to.x : from.x) + r) / tiles->tw );
+	int j0 = (int)floor( ((from.y < to.y ? from.y : to.y) - r) / tiles->th );
+	int j1 = (int)floor( ((from.y < to.y ? to.y : from.y) + r) / tiles->th );
+	if( i0 < 0 ) i0 = 0;
+	if( j0 < 0 ) j0 = 0;
+	if( tiles->fullcols-1 < i1 ) i1 = tiles->fullcols-1;
+	if( tiles->fullrows-1 < j1 ) j1 = tiles->fullrows-1;
+
+	T best = 2;
+
+	for( int j = j0; j <= j1; j++ )
+	{
+		for( int i = i0; i <= i1; i++ )
+		{
+			int k = tiles->Index(i, j);
+			int ID = tiles->id[k];
+			if( ID == TID_EMPTY )
+				continue;
+
+			//box of the solid part of the cell
+			T x0 = i*tiles->tw;
+			T x1 = x0 + tiles->tw;
+			T y0 = j*tiles->th;
+			T y1 = y0 + tiles->th;
+			if( tiles->ctype[k] == CTYPE_HALF )
+			{
+				const TileShape &shape = tiles->shapes[ID];
+				if( 0 < shape.signx ) x1 -= tiles->xw;//normal points right: the left half is solid
+				if( shape.signx < 0 ) x0 += tiles->xw;
+				if( 0 < shape.signy ) y1 -= tiles->yw;
+				if( shape.signy < 0 ) y0 += tiles->yw;
+			}
+
+			//faces shared with a full neighbor are inside solid ground, and can't be hit first
+			T t;
+			if( x0 == i*tiles->tw && (i == 0 || tiles->id[tiles->Index(i-1,j)] != TID_FULL) )
+			{
+				t = SweepFaceX<T>(x0, y0, y1, -1, from, d, r, rad);
+				if( t < best ) best = t;
+			}
+			if( x1 == (i+1)*tiles->tw && (i == tiles->fullcols-1 || tiles->id[tiles->Index(i+1,j)] != TID_FULL) )
+			{
+				t = SweepFaceX<T>(x1, y0, y1, 1, from, d, r, rad);
+				if( t < best ) best = t;
+			}
+			if( y0 == j*tiles->th && (j == 0 || tiles->id[tiles->Index(i,j-1)] != TID_FULL) )
+			{
+				t = SweepFaceY<T>(y0, x0, x1, -1, from, d, r, rad);
+				if( t < best ) best = t;
+			}
+			if( y1 == (j+1)*tiles->th && (j == tiles->fullrows-1 || tiles->id[tiles->Index(i,j+1)] != TID_FULL) )
+			{
+				t = SweepFaceY<T>(y1, x0, x1, 1, from, d, r, rad);
+				if( t < best ) best = t;
+			}
+
+			//the inner face of a half tile is never shared
+			if( x0 != i*tiles->tw ) { t = SweepFaceX<T>(x0, y0, y1, -1, from, d, r, rad); if( t < best ) best = t; }
+			if( x1 != (i+1)*tiles->tw ) { t = SweepFaceX<T>(x1, y0, y1, 1, from, d, r, rad); if( t < best ) best = t; }
+			if( y0 != j*tiles->th ) { t = SweepFaceY<T>(y0, x0, x1, -1, from, d, r, rad); if( t < best ) best = t; }
+			if( y1 != (j+1)*tiles->th ) { t = SweepFaceY<T>(y1, x0, x1, 1, from, d, r, rad); if( t < best ) best = t; }
+
+			//corners
+			t = SweepVertex<T>(x0, y0, from, d, r, rad); if( t < best ) best = t;
+			t = SweepVertex<T>(x1, y0, from, d, r, rad); if( t < best ) best = t;
+			t = SweepVertex<T>(x0, y1, from, d, r, rad); if( t < best ) best = t;
+			t = SweepVertex<T>(x1, y1, from, d, r, rad); if( t < best ) best = t;
+		}
+	}
+
+	return best;
+}
+
+//call this after IntegrateVerlet() and before CollideCirclevsTileMap(); it resolves
+//every contact along the way, and leaves the circle where it ends up this step.
+template<class T>
+void BodyT<T>::SweepCirclevsTileMap( TileGrid *tiles )
+{
+	Vector2T< T > from = oldpos;//where the circle was at the start of the step
+	T left = 1;//how much of this step's motion is left
+
+	for( int n = 0; n < SWEEP_MAX; n++ )
+	{
+		T t = SweepTimeOfImpact(tiles, from, pos);
+		if( 1 < t )
+			return;//nothing in the way
+
+		//back up to the point of contact, keeping the velocity
+		Vector2T< T > v = pos - oldpos;
+		pos = from + t*(pos - from);
+		oldpos = pos - v;
+
+		CollideCirclevsTileMap( Cell(tiles) );
+		if( dead )
+			return;
+
+		//..and carry on with the rest of the motion, with the new velocity
+		left *= (1 - t);
+		v = pos - oldpos;
+		from = pos;
+		pos += v*left;
+		oldpos += v*left;
+	}
+}
+
+
+//this function detects a collision between a circle and an edge-based tilemap,
+//and (if collision is found) calls ResolveCircleTile() to resolve the collision
+//
+//the main difference bewteen circle and aabb collision is that circles need to 
+//collide against vertices as well as edges.
+//
+//since vertices in the tilemap are implicit, we need to do a bit more work than with AABBs.
+//the logic is based upon the cell-index offset form the circle to the tile.
+//
+//if the circle is colliding with the current tile, we use the same logic as for the AABB.
+//otherwise, we have to consider extra cases..
+
+//(padx,pady) is the top-left of the pad and padw its width, as the Pad widget used to report them.
+template<class T>
+void BodyT<T>::CollideCirclevsPad    ( const int &padx, const int &pady, const int &padw, const TileRef &c )
+{
+	Vector2T< T > posn = pos;
+	T py,dx,dy;
+	
+	if( posn.y > 320 && posn.y < 360 ) {
+		
+		if( pos.x >= padx-20 && pos.x <= padx-13 + padw ) {
+			
+			dx = posn.x - CenterX<T>(c);
+			dy = posn.y - CenterY<T>(c);
+			py = ( abs( dy ) + r ) - c.yw();
+			
+			if( dy > 0 && py > 0 ) {
+				ReportCollisionVsWorld(0, -py, 0, -1, TileRef());
+			}
+		}
+		else if( pos.x < padx-20 ) {
+			
+			T vx = padx-20;
+			T vy = pady-18;
+			
+			dx = pos.x - vx;//calc vert->circle vector		
+			dy = pos.y - vy;
+			
+			T len = sqrt(dx*dx + dy*dy);
+			T pen = r - len;
+			
+			if(0 < pen)
+			{
+				//vertex is in the circle; project outward
+				if(len == 0)
+				{
+					//project out by 45deg
+					dx = -1 / sqrt((T)2);
+					dy = -1 / sqrt((T)2);
+				}
+				else
+				{
+					dx /= len;
+					dy /= len;
+				}
+
+				ReportCollisionVsWorld(dx*pen, dy*pen, dx, dy, TileRef());
+			}
+		}
+		else if( pos.x > padx-13 + padw ) {
+			
+			T vx = padx-13 + padw;
+			T vy = pady-18;
+			
+			dx = pos.x - vx;//calc vert->circle vector		
+			dy = pos.y - vy;
+			
+			T len = sqrt(dx*dx + dy*dy);
+			T pen = r - len;
+			
+			if(0 < pen)
+			{
+				//vertex is in the circle; project outward
+				if(len == 0)
+				{
+					//project out by 45deg
+					dx = -1 / sqrt((T)2);
+					dy = -1 / sqrt((T)2);
+				}
+				else
+				{
+					dx /= len;
+					dy /= len;
+				}
+
+				ReportCollisionVsWorld(dx*pen, dy*pen, dx, dy, TileRef());
+			}
+		}
+	}
+}
+
+template<class T>
+void BodyT<T>::CollideCirclevsTileMap( const TileRef &c )
+{
+	Vector2T< T > posn = pos;
+	int rad = r;
+	//var c = tiles.GetTile_V(pos);
+	
+	if( posn.y > (T)c.map->killY ) {
+		Die();
+		return;
+	}
+	
+	//c has to have a cell on every side for the kernels to look at; a body in
+	//the edge of the grid, or past it, has gone into or through the wall
+	//(pushed by other balls, too fast for it, or put there), and dies as if
+	//it had fallen off
+	if( c.i < 1 || c.map->fullcols-1 <= c.i || c.j < 1 || c.map->fullrows-1 <= c.j ) {
+		Die();
+		return;
+	}
+	
+	T tx = CenterX<T>(c);
+	T ty = CenterY<T>(c);
+	int txw = c.xw();
+	int tyw = c.yw();
+	
+
+	T dx = (pos.x - tx);//tile->obj delta
+	T dy = (pos.y - ty);
+	
+	if(0 < c.ID())
+	{
+		//current tile is full!! 
+		//for now, move object to oldpos; later, we'll need to determine projection direction and resolve
+		//the collision
+	
+		T px = (txw + rad) - abs(dx);//penetration depth in x	
+		T py = (tyw + rad) - abs(dy);//pen depth in y
+
+		ResolveCircleTile(px,py,0,0,this,c);
+	}
+
+
+	int oH, oV;
+		
+//test in y		
+		int crossV = false;//these flags will indicate whether or not we should collide vs. the diagonal tile
+		int hitV = false;
+			
+		dy = (pos.y - ty);//tile->obj delta
+		T py = (abs(dy) + rad) - tyw;//pen depth in y
+				
+		if(0 < py)
+		{
+			crossV = true;
+			
+			int eV;
+			TileRef nV;
+			//int oV;//store edge, neighbor, and cell offset
+			
+			if(dy < 0)
+			{
+				eV = c.eU();
+				nV = c.nU();
+				oV = 1;
+			}
+			else
+			{
+				eV = c.eD();
+				nV = c.nD();
+				oV = -1;
+			}
+				
+			if(0 < eV)
+			{
+				//edge is solid or interesting
+				if(eV == EID_SOLID)
+				{
+					//we're colliding with a solid edge; resolve right away
+					hitV = COL_AXIS;
+					ReportCollisionVsWorld(0,py*oV, 0, oV, nV);
+				}
+				else
+				{
+					//edge is interesting; resolve using tile-specific function
+					hitV = ResolveCircleTile(0,py,0,oV,this,nV);
+				}
+			}
+
+
+		}
+
+//test in x
+		int crossH = false;
+		int hitH = false;
+		
+		//T dx = (pos.x - tx);//tile->obj delta	
+		T px = (abs(dx) + rad) - txw;//penetration depth in x	
+
+		if(0 < px)
+		{
+			crossH = true;//aabb crosses horizontal edge
+	
+			int eH;
+			TileRef nH;
+			//int oH;
+			
+			if(dx < 0)
+			{
+				eH = c.eL();
+				nH = c.nL();
+				oH = 1;
+			}
+			else
+			{
+				eH = c.eR();
+				nH = c.nR();
+				oH = -1;			
+			}
+		
+			if(0 < eH)
+			{
+				//edge is solid or interesting
+				if(eH == EID_SOLID)
+				{
+					//we're colliding with a solid edge; resolve right away
+					hitH = COL_AXIS;
+					ReportCollisionVsWorld(px*oH, 0, oH, 0, nH);
+				}
+				else
+				{
+					//edge is interesting; resolve using tile-specific function
+					hitH = ResolveCircleTile(px,0,oH,0,this,nH);
+				}
+			}
+		}		
+		
+		//we should collide vs. the diagonal ONLY if the following are true:
+		//-object overlaps cell edge vertically but wasn't moved vertically to resolve this
+		//-object overlaps cell edge horizontally but wasn't moved horizontally to resolve this
+		//-adx and ady should both NOT be 0; if they ARE 0, the object is in the center of the tile
+		//and thus (since objects must be smaller than tiles) should never be able to collide
+		//with the diagonal
+
+		//NOTE: the diagonal testing is VERY inefficient!
+		
+		if((crossH)&&(hitH != COL_AXIS)&&(crossV)&&(hitV != COL_AXIS))
+		{
+
+			//we didn't collide with horiz or vert neighbors; test the diagonal neighbor
+			//NOTE: just as we used the current cell's edges and the h/v neighbor's cell states
+			//to test horizontally/vertically, we use the h/v neighbor's edges and the diagonal
+			//neighb's cell state to test diagonally
+			
+			//note that we can assume that the object is hitting the diagonal edges. we KNOW this
+			//due to the testD flag.
+
+			TileRef dTile;//this should hold a handle to the diagonal neighbot, IF we're colliding
+			//int hit = false;//flag to indocate if we should resolve collision or not
+			
+			int eH, eV;
+			
+			//the basic logic for a circle is: if EITHER edge is solid, we're colliding with the 
+			//corner vertex and we need to project out. otherwise, if at least one edge is
+			//non-off, we need to investigate.
+			
+			if((dx < 0) && (dy < 0))
+			{
+				//test top-left neighbor
+
+				eH = c.nU().eL();
+				eV = c.nL().eU();
+				dTile = c.nU().nL();
+				
+			}
+			else if((dx < 0) && (0 < dy))
+			{
+				//test bottom-left neighbor
+
+				eH = c.nD().eL();
+				eV = c.nL().eD();
+				dTile = c.nD().nL();
+				
+			}			
+			else if((0 < dx) && (0 < dy))
+			{
+				//test bottom-right neighbor
+				
+				eH = c.nD().eR();
+				eV = c.nR().eD();
+				dTile = c.nD().nR();
+
+			}			
+			else if((0 < dx) && (dy < 0))
+			{
+				//test top-right neighbor
+				
+				eH = c.nU().eR();
+				eV = c.nR().eU();
+				dTile = c.nU().nR();
+				
+			}
+			else
+			{
+				//object is in exact center of current cell.. we should never have reached here because
+				//they could never have touched any cell edges
+				//"WARNING!! we're colliding vs. diagonal but the object is in the dead center of it's cell!!"
+				eH = EID_OFF;
+				eV = EID_OFF;
+			}
+
+			
+			if(0 < (eH + eV))
+			{
+				//at least one edge is non-off
+				if((eH == EID_SOLID) || (eV == EID_SOLID))
+				{
+					//at least one of the edges is solid; project out of the corresponding corner vertex
+					T vx = CenterX<T>(dTile) + (oH*dTile.xw());
+					T vy = CenterY<T>(dTile) + (oV*dTile.yw());
+					
+					T dx = pos.x - vx;//calc vert->circle vector		
+					T dy = pos.y - vy;
+					
+					T len = sqrt(dx*dx + dy*dy);
+					T pen = r - len;
+					
+					if(0 < pen)
+					{
+						//vertex is in the circle; project outward
+						if(len == 0)
+						{
+							//project out by 45deg
+							dx = oH / (T)SQRT2;
+							dy = oV / (T)SQRT2;
+						}
+						else
+						{
+							dx /= len;
+							dy /= len;
+						}
+
+						ReportCollisionVsWorld(dx*pen, dy*pen, dx, dy, dTile);
+					}
+				}
+				else
+				{
+					//at least one of the edges is interesting; investigate
+					//note that we need to update the penetration info since 
+					//we may have projected the object horiz/vert
+					
+					dx = (pos.x - CenterX<T>(dTile));//tile->obj delta
+					dy = (pos.y - CenterY<T>(dTile));					
+					px = (abs(dx) + rad) - dTile.xw();//penetration depth in x	
+					py = (abs(dy) + rad) - dTile.yw();//penetration depth in y
+					
+					ResolveCircleTile(px,py,oH,oV,this,dTile);
+					
+				}
+			}
+			else
+			{
+				//both edges are off; do nothing
+			}
+
+		}
+}
+
+
+
+//this function resolves the collision between an object and a tile,
+//based on the tile type. (x,y) is the  projection vector.
+//this function returns true IF it moves the object by the specified
+//projection vector
+
+//NOTE: the cell offset vector (oH,oV) relative to the _tile_, i.e if the
+//circle is being tested against the tile to its left, oH = 1
+
+/* --------------- IGNORE THESE...   JUST FOR REFERENCES ----------------------
+Proj_CircleTile = new Object();//hash object to hold tile-specific collision functions
+Proj_CircleTile[CTYPE_FULL] = ProjCircle_Full;
+Proj_CircleTile[CTYPE_45DEG] = ProjCircle_45Deg;
+Proj_CircleTile[CTYPE_CONCAVE] = ProjCircle_Concave;
+Proj_CircleTile[CTYPE_CONVEX] = ProjCircle_Convex;
+Proj_CircleTile[CTYPE_22DEGs] = ProjCircle_22DegS;
+Proj_CircleTile[CTYPE_22DEGb] = ProjCircle_22DegB;
+Proj_CircleTile[CTYPE_67DEGs] = ProjCircle_67DegS;
+Proj_CircleTile[CTYPE_67DEGb] = ProjCircle_67DegB;
+Proj_CircleTile[CTYPE_HALF] = ProjCircle_Half;
+------------------------------------------------------------------ */
+
+//the kernels of BodyT<T> for every tile ID and cell offset, built at compile
+//time: ProjCircleTable<T>::fn[ID][oH+1][oV+1]. ID 0 (empty) has no kernels.
+
+template<class T> using ProjCircleFn = int (BodyT<T>::*)(T x, T y, BodyT<T> *obj, const TileRef &t);
+
+//which kernel family handles a CTYPE
+template<class T, int CTYPE> struct ProjCircleKernel;
+template<class T> struct ProjCircleKernel<T, CTYPE_FULL>    { template<int ID, int oH, int oV> static constexpr ProjCircleFn<T> Get() { return &BodyT<T>::template ProjCircle_Full<ID,oH,oV>; } };
+template<class T> struct ProjCircleKernel<T, CTYPE_45DEG>   { template<int ID, int oH, int oV> static constexpr ProjCircleFn<T> Get() { return &BodyT<T>::template ProjCircle_45Deg<ID,oH,oV>; } };
+template<class T> struct ProjCircleKernel<T, CTYPE_CONCAVE> { template<int ID, int oH, int oV> static constexpr ProjCircleFn<T> Get() { return &BodyT<T>::template ProjCircle_Concave<ID,oH,oV>; } };
+template<class T> struct ProjCircleKernel<T, CTYPE_CONVEX>  { template<int ID, int oH, int oV> static constexpr ProjCircleFn<T> Get() { return &BodyT<T>::template ProjCircle_Convex<ID,oH,oV>; } };
+template<class T> struct ProjCircleKernel<T, CTYPE_22DEGs>  { template<int ID, int oH, int oV> static constexpr ProjCircleFn<T> Get() { return &BodyT<T>::template ProjCircle_22DegS<ID,oH,oV>; } };
+template<class T> struct ProjCircleKernel<T, CTYPE_22DEGb>  { template<int ID, int oH, int oV> static constexpr ProjCircleFn<T> Get() { return &BodyT<T>::template ProjCircle_22DegB<ID,oH,oV>; } };
+template<class T> struct ProjCircleKernel<T, CTYPE_67DEGs>  { template<int ID, int oH, int oV> static constexpr ProjCircleFn<T> Get() { return &BodyT<T>::template ProjCircle_67DegS<ID,oH,oV>; } };
+template<class T> struct ProjCircleKernel<T, CTYPE_67DEGb>  { template<int ID, int oH, int oV> static constexpr ProjCircleFn<T> Get() { return &BodyT<T>::template ProjCircle_67DegB<ID,oH,oV>; } };
+template<class T> struct ProjCircleKernel<T, CTYPE_HALF>    { template<int ID, int oH, int oV> static constexpr ProjCircleFn<T> Get() { return &BodyT<T>::template ProjCircle_Half<ID,oH,oV>; } };
+
+//CTYPE of a (non-empty) ID; IDs 2..29 come in groups of 4 sharing a CTYPE
+constexpr int ProjCircleCType(const int &ID)
+{
+	return (ID == TID_FULL) ? CTYPE_FULL :
+		(ID < TID_HALFd) ? TID_45DEGpn + ((ID - TID_45DEGpn) / 4) * 4 :
+		CTYPE_HALF;
+}
+
+#define PROJ_KERNEL(ID, oH, oV) ProjCircleKernel< T, ProjCircleCType(ID) >::template Get<ID,oH,oV>()
+#define PROJ_KERNELS(ID) { { PROJ_KERNEL(ID,-1,-1), PROJ_KERNEL(ID,-1,0), PROJ_KERNEL(ID,-1,1) }, \
+						   { PROJ_KERNEL(ID, 0,-1), PROJ_KERNEL(ID, 0,0), PROJ_KERNEL(ID, 0,1) }, \
+						   { PROJ_KERNEL(ID, 1,-1), PROJ_KERNEL(ID, 1,0), PROJ_KERNEL(ID, 1,1) } }
+
+template<class T> struct ProjCircleTable
+{
+	static constexpr ProjCircleFn<T> fn[TID_COUNT][3][3] = {
+		{ { NULL, NULL, NULL }, { NULL, NULL, NULL }, { NULL, NULL, NULL } },//TID_EMPTY
+		PROJ_KERNELS(1),  PROJ_KERNELS(2),  PROJ_KERNELS(3),  PROJ_KERNELS(4),  PROJ_KERNELS(5),
+		PROJ_KERNELS(6),  PROJ_KERNELS(7),  PROJ_KERNELS(8),  PROJ_KERNELS(9),  PROJ_KERNELS(10),
+		PROJ_KERNELS(11), PROJ_KERNELS(12), PROJ_KERNELS(13), PROJ_KERNELS(14), PROJ_KERNELS(15),
+		PROJ_KERNELS(16), PROJ_KERNELS(17), PROJ_KERNELS(18), PROJ_KERNELS(19), PROJ_KERNELS(20),
+		PROJ_KERNELS(21), PROJ_KERNELS(22), PROJ_KERNELS(23), PROJ_KERNELS(24), PROJ_KERNELS(25),
+		PROJ_KERNELS(26), PROJ_KERNELS(27), PROJ_KERNELS(28), PROJ_KERNELS(29), PROJ_KERNELS(30),
+		PROJ_KERNELS(31), PROJ_KERNELS(32), PROJ_KERNELS(33)
+	};
+};
+
+template<class T> constexpr ProjCircleFn<T> ProjCircleTable<T>::fn[TID_COUNT][3][3];
+
+#undef PROJ_KERNELS
+#undef PROJ_KERNEL
+
+template<class T>
+int BodyT<T>::ResolveCircleTile(const T &x, const T &y, const int &oH, const int &oV, BodyT *obj, const TileRef &t)
+{
+	int ID = t.ID();
+	if( 0 < ID )
+	{
+		return (this->*ProjCircleTable<T>::fn[ID][oH+1][oV+1])(x,y,obj,t);
+	}
+	else
+	{
+		//"ResolveCircleTile() was called with an empty (or unknown) tile!)"
+		return false;
+	}
+}
+
+
+template<class T> template<int ID, int oH, int oV>
+int BodyT<T>::ProjCircle_Full(T x, T y, BodyT *obj, const TileRef &t)
+{
+	//if we're colliding vs. the current cell, we need to project along the
+	//smallest penetration vector.
+	//if we're colliding vs. horiz. or vert. neighb, we simply project horiz/vert
+	//if we're colliding diagonally, we need to collide vs. tile corner
+		
+		if(oH == 0)
+		{
+			if(oV == 0)
+			{
+
+				//collision with current cell
+				if(x < y)
+				{					
+					//penetration in x is smaller; project in x
+					T dx = obj->pos.x - CenterX<T>(t);//get sign for projection along x-axis
+					
+			
+					
+					//NOTE: should we handle the delta == 0 case?! and how? (project towards oldpos?)
+					if(dx < 0)
+					{
+						obj->ReportCollisionVsWorld(-x,0,-1,0,t);
+						return COL_AXIS;
+					}
+					else
+					{
+						obj->ReportCollisionVsWorld(x,0,1,0,t);
+						return COL_AXIS;
+					}
+				}
+				else
+				{		
+					//penetration in y is smaller; project in y		
+					T dy = obj->pos.y - CenterY<T>(t);//get sign for projection along y-axis
+
+					//NOTE: should we handle the delta == 0 case?! and how? (project towards oldpos?)					
+					if(dy < 0)
+					{
+						obj->ReportCollisionVsWorld(0,-y,0,-1,t);
+						return COL_AXIS;
+					}
+					else
+					{
+						obj->ReportCollisionVsWorld(0,y,0,1,t);
+						return COL_AXIS;
+					}				
+				}					
+			}
+			else
+			{
+				//collision with vertical neighbor
+				obj->ReportCollisionVsWorld(0,y*oV,0,oV,t);
+
+				return COL_AXIS;
+			}
+		}
+		else if(oV == 0)
+		{
+			//collision with horizontal neighbor
+			obj->ReportCollisionVsWorld(x*oH,0,oH,0,t);
+			return COL_AXIS;
+		}
+		else
+		{			
+			//diagonal collision
+			
+			//get diag vertex position
+			T vx = CenterX<T>(t) + (oH*t.xw());
+			T vy = CenterY<T>(t) + (oV*t.yw());
+			
+			T dx = obj->pos.x - vx;//calc vert->circle vector		
+			T dy = obj->pos.y - vy;
+			
+			T len = sqrt(dx*dx + dy*dy);
+			T pen = obj->r - len;
+			if(0 < pen)
+			{
+				//vertex is in the circle; project outward
+				if(len == 0)
+				{
+					//project out by 45deg
+					dx = oH / (T)SQRT2;
+					dy = oV / (T)SQRT2;
+				}
+				else
+				{
+					dx /= len;
+					dy /= len;
+				}
+				
+				obj->ReportCollisionVsWorld(dx*pen, dy*pen, dx, dy, t);
+				
+				return COL_OTHER;
+			}
+		}
+		
+		return COL_NONE;
+}
+
+
+template<class T> template<int ID, int oH, int oV>
+int BodyT<T>::ProjCircle_Half(T x, T y, BodyT *obj, const TileRef &t)
+{
+
+	//if obj is in a neighbor pointed at by the halfedge normal,
+	//we'll never collide (i.e if the normal is (0,1) and the obj is in the DL.D, or R neighbors)
+	//
+	//if obj is in a neigbor perpendicular to the halfedge normal, it might
+	//collide with the halfedge-vertex, or with the halfedge side.
+	//
+	//if obj is in a neigb pointing opposite the halfedge normal, obj collides with edge
+	//
+	//if obj is in a diagonal (pointing away from the normal), obj collides vs vertex
+	//
+	//if obj is in the halfedge cell, it collides as with aabb
+
+	const int signx = EdgeSignX(ID);
+	const int signy = EdgeSignY(ID);
+
+	int celldp = (oH*signx + oV*signy);//this tells us about the configuration of cell-offset relative to tile normal
+	if(0 < celldp)
+	{
+		//obj is in "far" (pointed-at-by-normal) neighbor of halffull tile, and will never hit
+		return COL_NONE;
+	}
+	else if(oH == 0)
+	{
+		if(oV == 0)
+		{
+			//colliding with current tile
+			int r = obj->r;
+			T ox = (obj->pos.x - (signx*r)) - CenterX<T>(t);//this gives is the coordinates of the innermost
+			T oy = (obj->pos.y - (signy*r)) - CenterY<T>(t);//point on the circle, relative to the tile center
+			
+	
+			//we perform operations analogous to the 45deg tile, except we're using 
+			//an axis-aligned slope instead of an angled one..
+			T sx = signx;
+			T sy = signy;
+			
+			//if the dotprod of (ox,oy) and (sx,sy) is negative, the corner is in the slope
+			//and we need toproject it out by the magnitude of the projection of (ox,oy) onto (sx,sy)
+			T dp = (ox*sx) + (oy*sy);
+			if(dp < 0)
+			{
+				//collision; project delta onto slope and use this to displace the object
+				sx *= -dp;//(sx,sy) is now the projection vector
+				sy *= -dp;		
+				
+				
+				T lenN = sqrt(sx*sx + sy*sy);
+				T lenP = sqrt(x*x + y*y);
+	
+				if(lenP < lenN)
+				{
+					obj->ReportCollisionVsWorld(x,y,x/lenP, y/lenP, t );
+
+					return COL_AXIS;
+				}
+				else
+				{		
+					obj->ReportCollisionVsWorld(sx,sy,signx,signy, t);
+
+					return COL_OTHER;
+				}
+				return true;
+			}			
+			
+		}
+		else
+		{
+			//colliding vertically
+
+			if(celldp == 0)
+			{
+	
+				int r = obj->r;
+				T dx = obj->pos.x - CenterX<T>(t);
+						
+				//we're in a cell perpendicular to the normal, and can collide vs. halfedge vertex
+				//or halfedge side
+				if((dx*signx) < 0)
+				{
+					//collision with halfedge side
+					obj->ReportCollisionVsWorld(0,y*oV,0,oV,t);
+					
+					return COL_AXIS;						
+				}
+				else
+				{
+					//collision with halfedge vertex
+					T dy = obj->pos.y - (CenterY<T>(t) + oV*t.yw());//(dx,dy) is now the vector from the appropriate halfedge vertex to the circle
+					
+					T len = sqrt(dx*dx + dy*dy);
+					T pen = r - len;
+					if(0 < pen)
+					{
+						//vertex is in the circle; project outward
+						if(len == 0)
+						{
+							//project out by 45deg
+							dx = signx / (T)SQRT2;
+							dy = oV / (T)SQRT2;
+						}
+						else
+						{
+							dx /= len;
+							dy /= len;
+						}
+							
+						obj->ReportCollisionVsWorld(dx*pen, dy*pen, dx, dy, t);
+						
+						return COL_OTHER;
+					}					
+					
+				}
+			}
+			else
+			{
+				//due to the first conditional (celldp >0), we know we're in the cell "opposite" the normal, and so
+				//we can only collide with the cell edge
+				//collision with vertical neighbor
+				obj->ReportCollisionVsWorld(0,y*oV,0,oV,t);
+				
+				return COL_AXIS;
+			}
+			
+		}
+	}
+	else if(oV == 0)
+	{
+		//colliding horizontally
+		if(celldp == 0)
+		{
+	
+			int r = obj->r;
+			T dy = obj->pos.y - CenterY<T>(t);
+						
+			//we're in a cell perpendicular to the normal, and can collide vs. halfedge vertex
+			//or halfedge side
+			if((dy*signy) < 0)
+			{
+				//collision with halfedge side
+				obj->ReportCollisionVsWorld(x*oH,0,oH,0,t);
+				
+				return COL_AXIS;						
+			}
+			else
+			{
+				//collision with halfedge vertex
+				T dx = obj->pos.x - (CenterX<T>(t) + oH*t.xw());//(dx,dy) is now the vector from the appropriate halfedge vertex to the circle
+					
+				T len = sqrt(dx*dx + dy*dy);
+				T pen = r - len;
+				if(0 < pen)
+				{
+					//vertex is in the circle; project outward
+					if(len == 0)
+					{
+						//project out by 45deg
+						dx = signx / (T)SQRT2;
+						dy = oV / (T)SQRT2;
+					}
+					else
+					{
+						dx /= len;
+						dy /= len;
+					}
+							
+					obj->ReportCollisionVsWorld(dx*pen, dy*pen, dx, dy, t);
+					
+					return COL_OTHER;
+				}					
+					
+			}
+		}
+		else
+		{			
+			//due to the first conditional (celldp >0), we know w're in the cell "opposite" the normal, and so
+			//we can only collide with the cell edge
+			obj->ReportCollisionVsWorld(x*oH, 0, oH, 0, t);
+			
+			return COL_AXIS;
+		}		
+	}
+	else
+	{		
+		//colliding diagonally; we know, due to the initial (celldp >0) test which has failed
+		//if we've reached this point, that we're in a diagonal neighbor on the non-normal side, so
+		//we could only be colliding with the cell vertex, if at all.
+
+		//get diag vertex position
+		T vx = CenterX<T>(t) + (oH*t.xw());
+		T vy = CenterY<T>(t) + (oV*t.yw());
+			
+		T dx = obj->pos.x - vx;//calc vert->circle vector		
+		T dy = obj->pos.y - vy;
+			
+		T len = sqrt(dx*dx + dy*dy);
+		T pen = obj->r - len;
+		if(0 < pen)
+		{
+			//vertex is in the circle; project outward
+			if(len == 0)
+			{
+				//project out by 45deg
+				dx = oH / (T)SQRT2;
+				dy = oV / (T)SQRT2;
+			}
+			else
+			{
+				dx /= len;
+				dy /= len;
+			}
+
+			obj->ReportCollisionVsWorld(dx*pen, dy*pen, dx, dy, t);
+			
+			return COL_OTHER;
+		}		
+		
+	}
+	
+	return COL_NONE;
+	
+}
+
+
+template<class T> template<int ID, int oH, int oV>
+int BodyT<T>::ProjCircle_45Deg(T x, T y, BodyT *obj, const TileRef &t)
+{
+
+	//if we're colliding diagonally:
+	//	-if obj is in the diagonal pointed to by the slope normal: we can't collide, do nothing
+	//  -else, collide vs. the appropriate vertex
+	//if obj is in this tile: perform collision as for aabb-ve-45deg
+	//if obj is horiz OR very neighb in direction of slope: collide only vs. slope
+	//if obj is horiz or vert neigh against direction of slope: collide vs. face
+	
+	const int signx = EdgeSignX(ID);
+	const int signy = EdgeSignY(ID);	
+	
+	if(oH == 0)
+	{
+		if(oV == 0)
+		{
+			//colliding with current tile
+
+			T sx = SlopeX<T>(t);
+			T sy = SlopeY<T>(t);
+			
+			T lenP;
+
+			T ox = (obj->pos.x - (sx*obj->r)) - CenterX<T>(t);//this gives is the coordinates of the innermost
+			T oy = (obj->pos.y - (sy*obj->r)) - CenterY<T>(t);//point on the circle, relative to the tile center	
+
+			//if the dotprod of (ox,oy) and (sx,sy) is negative, the innermost point is in the slope
+			//and we need toproject it out by the magnitude of the projection of (ox,oy) onto (sx,sy)
+			T dp = (ox*sx) + (oy*sy);		
+			if(dp < 0)
+			{
+				//collision; project delta onto slope and use this as the slope penetration vector
+				sx *= -dp;//(sx,sy) is now the penetration vector
+				sy *= -dp;		
+				
+				//find the smallest axial projection vector
+				if(x < y)
+				{					
+					//penetration in x is smaller
+					lenP = x;
+					y = 0;
+					
+					//get sign for projection along x-axis		
+					if((obj->pos.x - CenterX<T>(t)) < 0)
+					{
+						x *= -1;
+					}
+				}
+				else
+				{		
+					//penetration in y is smaller
+					lenP = y;
+					x = 0;
+					
+					//get sign for projection along y-axis		
+					if((obj->pos.y - CenterY<T>(t))< 0)
+					{
+						y *= -1;
+					}			
+				}
+
+				T lenN = sqrt(sx*sx + sy*sy);
+							
+				if(lenP < lenN)
+				{
+					obj->ReportCollisionVsWorld(x,y,x/lenP, y/lenP, t);
+					
+					return COL_AXIS;
+				}
+				else
+				{
+					obj->ReportCollisionVsWorld(sx,sy,SlopeX<T>(t),SlopeY<T>(t),t);
+					
+					return COL_OTHER;
+				}
+			}			
+
+		}
+		else
+		{
+			//colliding vertically
+			if((signy*oV) < 0)
+			{
+				//colliding with face/edge
+				obj->ReportCollisionVsWorld(0,y*oV,0,oV,t);
+				
+				return COL_AXIS;
+			}
+			else
+			{
+				//we could only be colliding vs the slope OR a vertex
+				//look at the vector form the closest vert to the circle to decide
+
+				T sx = SlopeX<T>(t);
+				T sy = SlopeY<T>(t);
+
+				T ox = obj->pos.x - (CenterX<T>(t) - (signx*t.xw()));//this gives is the coordinates of the innermost
+				T oy = obj->pos.y - (CenterY<T>(t) + (oV*t.yw()));//point on the circle, relative to the closest tile vert	
+
+				//if the component of (ox,oy) parallel to the normal's righthand normal
+				//has the same sign as the slope of the slope (the sign of the slope's slope is signx*signy)
+				//then we project by the vertex, otherwise by the normal.
+				//note that this is simply a VERY tricky/weird method of determining 
+				//if the circle is in side the slope/face's voronoi region, or that of the vertex.											  
+				T perp = (ox*-sy) + (oy*sx);
+				if(0 < (perp*signx*signy))
+				{
+					//collide vs. vertex
+					T len = sqrt(ox*ox + oy*oy);
+					T pen = obj->r - len;
+					if(0 < pen)
+					{
+						//note: if len=0, then perp=0 and we'll never reach here, so don't worry about div-by-0
+						ox /= len;
+						oy /= len;
+
+						obj->ReportCollisionVsWorld(ox*pen, oy*pen, ox, oy, t);
+						
+						return COL_OTHER;
+					}					
+				}
+				else
+				{
+					//collide vs. slope
+					
+					//if the component of (ox,oy) parallel to the normal is less than the circle radius, we're
+					//penetrating the slope. note that this method of penetration calculation doesn't hold
+					//in general (i.e it won't work if the circle is in the slope), but works in this case
+					//because we know the circle is in a neighboring cell
+					T dp = (ox*sx) + (oy*sy);
+					T pen = obj->r - abs(dp);//note: we don't need the abs because we know the dp will be positive, but just in case..
+					if(0 < pen)
+					{
+						//collision; circle out along normal by penetration amount
+						obj->ReportCollisionVsWorld(sx*pen, sy*pen, sx, sy, t);
+						
+						return COL_OTHER;
+					}
+				}
+			}
+		}		
+	}
+	else if(oV == 0)
+	{
+		//colliding horizontally
+		if((signx*oH) < 0)
+		{
+			//colliding with face/edge
+			obj->ReportCollisionVsWorld(x*oH, 0, oH, 0, t);
+			
+			return COL_AXIS;
+		}
+		else
+		{
+				//we could only be colliding vs the slope OR a vertex
+				//look at the vector form the closest vert to the circle to decide
+
+				T sx = SlopeX<T>(t);
+				T sy = SlopeY<T>(t);
+
+				T ox = obj->pos.x - (CenterX<T>(t) + (oH*t.xw()));//this gives is the coordinates of the innermost
+				T oy = obj->pos.y - (CenterY<T>(t) - (signy*t.yw()));//point on the circle, relative to the closest tile vert	
+
+				//if the component of (ox,oy) parallel to the normal's righthand normal
+				//has the same sign as the slope of the slope (the sign of the slope's slope is signx*signy)
+				//then we project by the normal, otherwise by the vertex.
+				//(NOTE: this is the opposite logic of the vertical case;
+				// for vertical, if the perp prod and the slope's slope agree, it's outside.
+				// for horizontal, if the perp prod and the slope's slope agree, circle is inside.
+				//  ..but this is only a property of flahs' coord system (i.e the rules might swap
+				// in righthanded systems))
+				//note that this is simply a VERY tricky/weird method of determining 
+				//if the circle is in side the slope/face's voronio region, or that of the vertex.											  
+				T perp = (ox*-sy) + (oy*sx);
+				if((perp*signx*signy) < 0)
+				{
+					//collide vs. vertex
+					T len = sqrt(ox*ox + oy*oy);
+					T pen = obj->r - len;
+					if(0 < pen)
+					{
+						//note: if len=0, then perp=0 and we'll never reach here, so don't worry about div-by-0
+						ox /= len;
+						oy /= len;
+
+						obj->ReportCollisionVsWorld(ox*pen, oy*pen, ox, oy, t);
+						
+						return COL_OTHER;
+					}					
+				}
+				else
+				{
+					//collide vs. slope
+					
+					//if the component of (ox,oy) parallel to the normal is less than the circle radius, we're
+					//penetrating the slope. note that this method of penetration calculation doesn't hold
+					//in general (i.e it won't work if the circle is in the slope), but works in this case
+					//because we know the circle is in a neighboring cell
+					T dp = (ox*sx) + (oy*sy);
+					T pen = obj->r - abs(dp);//note: we don't need the abs because we know the dp will be positive, but just in case..
+					if(0 < pen)
+					{
+						//collision; circle out along normal by penetration amount
+						obj->ReportCollisionVsWorld(sx*pen, sy*pen, sx, sy, t);
+						
+						return COL_OTHER;
+					}
+				}			
+		}
+	}
+	else
+	{
+		//colliding diagonally
+		if( 0 < ((signx*oH) + (signy*oV)) ) 
+		{
+			//the dotprod of slope normal and cell offset is strictly positive,
+			//therefore obj is in the diagonal neighb pointed at by the normal, and
+			//it cannot possibly reach/touch/penetrate the slope
+			return COL_NONE;
+		}
+		else
+		{
+			//collide vs. vertex
+			//get diag vertex position
+			T vx = CenterX<T>(t) + (oH*t.xw());
+			T vy = CenterY<T>(t) + (oV*t.yw());
+			
+			T dx = obj->pos.x - vx;//calc vert->circle vector		
+			T dy = obj->pos.y - vy;
+			
+			T len = sqrt(dx*dx + dy*dy);
+			T pen = obj->r - len;
+			if(0 < pen)
+			{
+				//vertex is in the circle; project outward
+				if(len == 0)
+				{
+					//project out by 45deg
+					dx = oH / (T)SQRT2;
+					dy = oV / (T)SQRT2;
+				}
+				else
+				{
+					dx /= len;
+					dy /= len;
+				}
+
+				obj->ReportCollisionVsWorld(dx*pen, dy*pen, dx, dy, t);
+				return COL_OTHER;
+			}
+	
+		}
+	
+	}
+
+	return COL_NONE;
+}
+
+
+template<class T> template<int ID, int oH, int oV>
+int BodyT<T>::ProjCircle_Concave(T x, T y, BodyT *obj, const TileRef &t)
+{
+
+	//if we're colliding diagonally:
+	//	-if obj is in the diagonal pointed to by the slope normal: we can't collide, do nothing
+	//  -else, collide vs. the appropriate vertex
+	//if obj is in this tile: perform collision as for aabb
+	//if obj is horiz OR very neighb in direction of slope: collide vs vert
+	//if obj is horiz or vert neigh against direction of slope: collide vs. face
+
+	const int signx = EdgeSignX(ID);
+	const int signy = EdgeSignY(ID);
+
+	if(oH == 0)
+	{
+		if(oV == 0)
+		{
+			//colliding with current tile
+			
+				T ox = (CenterX<T>(t) + (signx*t.xw())) - obj->pos.x;//(ox,oy) is the vector from the circle to 
+				T oy = (CenterY<T>(t) + (signy*t.yw())) - obj->pos.y;//tile-circle's center
+				
+				T lenP;
+		
+				int twid = t.xw()*2;
+				T trad = sqrt((T)(twid*twid + 0));//this gives us the radius of a circle centered on the tile's corner and extending to the opposite edge of the tile;
+												//note that this should be precomputed at compile-time since it's constant
+				
+				T len = sqrt(ox*ox + oy*oy);
+				T pen = (len + obj->r) - trad;
+
+				if(0 < pen)
+				{
+					//find the smallest axial projection vector
+					if(x < y)
+					{					
+						//penetration in x is smaller
+						lenP = x;
+						y = 0;
+						
+						//get sign for projection along x-axis		
+						if((obj->pos.x - CenterX<T>(t)) < 0)
+						{
+							x *= -1;
+						}
+					}
+					else
+					{		
+						//penetration in y is smaller
+						lenP = y;
+						x = 0;
+						
+						//get sign for projection along y-axis		
+						if((obj->pos.y - CenterY<T>(t))< 0)
+						{
+							y *= -1;
+						}			
+					}
+
+					
+					if(lenP < pen)
+					{
+						obj->ReportCollisionVsWorld(x,y,x/lenP, y/lenP, t);
+						
+						return COL_AXIS;
+					}
+					else
+					{
+						//we can assume that len >0, because if we're here then
+						//(len + obj->r) > trad, and since obj->r <= trad
+						//len MUST be > 0
+						ox /= len;
+						oy /= len;
+
+						obj->ReportCollisionVsWorld(ox*pen, oy*pen, ox, oy, t);
+						
+						return COL_OTHER;
+					}
+				}
+				else
+				{
+					return COL_NONE;
+				}
+
+		}
+		else
+		{
+			//colliding vertically
+			if((signy*oV) < 0)
+			{			
+				//colliding with face/edge
+				obj->ReportCollisionVsWorld(0,y*oV, 0, oV, t);
+				
+				return COL_AXIS;
+			}
+			else
+			{
+				//we could only be colliding vs the vertical tip
+
+				//get diag vertex position
+				T vx = CenterX<T>(t) - (signx*t.xw());
+				T vy = CenterY<T>(t) + (oV*t.yw());
+				
+				T dx = obj->pos.x - vx;//calc vert->circle vector		
+				T dy = obj->pos.y - vy;
+				
+				T len = sqrt(dx*dx + dy*dy);
+				T pen = obj->r - len;
+				if(0 < pen)
+				{
+					//vertex is in the circle; project outward
+					if(len == 0)
+					{
+						//project out vertically
+						dx = 0;
+						dy = oV;
+					}
+					else
+					{
+						dx /= len;
+						dy /= len;
+					}
+
+					obj->ReportCollisionVsWorld(dx*pen, dy*pen, dx, dy, t);
+					
+					return COL_OTHER;
+				}
+			}
+		}		
+	}
+	else if(oV == 0)
+	{
+		//colliding horizontally
+		if((signx*oH) < 0)
+		{
+			//colliding with face/edge
+			obj->ReportCollisionVsWorld(x*oH, 0, oH, 0, t);
+			
+			return COL_AXIS;
+		}
+		else
+		{
+				//we could only be colliding vs the horizontal tip
+
+				//get diag vertex position
+				T vx = CenterX<T>(t) + (oH*t.xw());
+				T vy = CenterY<T>(t) - (signy*t.yw());
+				
+				T dx = obj->pos.x - vx;//calc vert->circle vector		
+				T dy = obj->pos.y - vy;
+				
+				T len = sqrt(dx*dx + dy*dy);
+				T pen = obj->r - len;
+				if(0 < pen)
+				{
+					//vertex is in the circle; project outward
+					if(len == 0)
+					{
+						//project out horizontally
+						dx = oH;
+						dy = 0;
+					}
+					else
+					{
+						dx /= len;
+						dy /= len;
+					}
+
+					obj->ReportCollisionVsWorld(dx*pen, dy*pen, dx, dy, t);
+					
+					return COL_OTHER;
+				}	
+		}
+	}
+	else
+	{
+		//colliding diagonally
+		if( 0 < ((signx*oH) + (signy*oV)) ) 
+		{
+			//the dotprod of slope normal and cell offset is strictly positive,
+			//therefore obj is in the diagonal neighb pointed at by the normal, and
+			//it cannot possibly reach/touch/penetrate the slope
+			return COL_NONE;
+		}
+		else
+		{
+			//collide vs. vertex
+			//get diag vertex position
+			T vx = CenterX<T>(t) + (oH*t.xw());
+			T vy = CenterY<T>(t) + (oV*t.yw());
+			
+			T dx = obj->pos.x - vx;//calc vert->circle vector		
+			T dy = obj->pos.y - vy;
+			
+			T len = sqrt(dx*dx + dy*dy);
+			T pen = obj->r - len;
+			if(0 < pen)
+			{
+				//vertex is in the circle; project outward
+				if(len == 0)
+				{
+					//project out by 45deg
+					dx = oH / (T)SQRT2;
+					dy = oV / (T)SQRT2;
+				}
+				else
+				{
+					dx /= len;
+					dy /= len;
+				}
+
+				obj->ReportCollisionVsWorld(dx*pen, dy*pen, dx, dy, t);
+				
+				return COL_OTHER;
+			}
+	
+		}
+	
+	}
+
+	return COL_NONE;
+	
+}
+
+
+template<class T> template<int ID, int oH, int oV>
+int BodyT<T>::ProjCircle_Convex(T x, T y, BodyT *obj, const TileRef &t)
+{
+	//if the object is horiz AND/OR vertical neighbor in the normal (signx,signy)
+	//direction, collide vs. tile-circle only.
+	//if we're colliding diagonally:
+	//  -else, collide vs. the appropriate vertex
+	//if obj is in this tile: perform collision as for aabb
+	//if obj is horiz or vert neigh against direction of slope: collide vs. face
+
+	const int signx = EdgeSignX(ID);
+	const int signy = EdgeSignY(ID);
+
+	if(oH == 0)
+	{
+		if(oV == 0)
+		{
+			//colliding with current tile
+				
+				
+				T ox = obj->pos.x - (CenterX<T>(t) - (signx*t.xw()));//(ox,oy) is the vector from the tile-circle to 
+				T oy = obj->pos.y - (CenterY<T>(t) - (signy*t.yw()));//the circle's center
+				
+				T lenP;
+		
+				int twid = t.xw()*2;
+				T trad = sqrt((T)(twid*twid + 0));//this gives us the radius of a circle centered on the tile's corner and extending to the opposite edge of the tile;
+												//note that this should be precomputed at compile-time since it's constant
+				
+				T len = sqrt(ox*ox + oy*oy);
+				T pen = (trad + obj->r) - len;
+
+				if(0 < pen)
+				{
+					//find the smallest axial projection vector
+					if(x < y)
+					{					
+						//penetration in x is smaller
+						lenP = x;
+						y = 0;
+						
+						//get sign for projection along x-axis		
+						if((obj->pos.x - CenterX<T>(t)) < 0)
+						{
+							x *= -1;
+						}
+					}
+					else
+					{		
+						//penetration in y is smaller
+						lenP = y;
+						x = 0;
+						
+						//get sign for projection along y-axis		
+						if((obj->pos.y - CenterY<T>(t))< 0)
+						{
+							y *= -1;
+						}			
+					}
+
+					
+					if(lenP < pen)
+					{
+						obj->ReportCollisionVsWorld(x, y, x/lenP, y/lenP, t);
+						
+						return COL_AXIS;
+					}
+					else
+					{
+						//note: len should NEVER be == 0, because if it is, 
+						//projeciton by an axis shoudl always be shorter, and we should
+						//never arrive here
+						ox /= len;
+						oy /= len;
+						
+						obj->ReportCollisionVsWorld(ox*pen, oy*pen, ox, oy, t);
+						
+						return COL_OTHER;
+						
+					}
+				}
+		}
+		else
+		{
+			//colliding vertically
+			if((signy*oV) < 0)
+			{
+				//colliding with face/edge
+				obj->ReportCollisionVsWorld(0, y*oV, 0, oV, t);
+				
+				return COL_AXIS;
+			}
+			else
+			{
+				//obj in neighboring cell pointed at by tile normal;
+				//we could only be colliding vs the tile-circle surface
+
+				T ox = obj->pos.x - (CenterX<T>(t) - (signx*t.xw()));//(ox,oy) is the vector from the tile-circle to 
+				T oy = obj->pos.y - (CenterY<T>(t) - (signy*t.yw()));//the circle's center
+		
+				int twid = t.xw()*2;
+				T trad = sqrt((T)(twid*twid + 0));//this gives us the radius of a circle centered on the tile's corner and extending to the opposite edge of the tile;
+												//note that this should be precomputed at compile-time since it's constant
+				
+				T len = sqrt(ox*ox + oy*oy);
+				T pen = (trad + obj->r) - len;
+
+				if(0 < pen)
+				{
+
+					//note: len should NEVER be == 0, because if it is, 
+					//obj is not in a neighboring cell!
+					ox /= len;
+					oy /= len;
+						
+					obj->ReportCollisionVsWorld(ox*pen, oy*pen, ox, oy, t);
+					
+					return COL_OTHER;
+				}
+			}
+		}		
+	}
+	else if(oV == 0)
+	{
+		//colliding horizontally
+		if((signx*oH) < 0)
+		{
+			//colliding with face/edge
+			obj->ReportCollisionVsWorld(x*oH, 0, oH, 0, t);
+			
+			return COL_AXIS;
+		}
+		else
+		{
+				//obj in neighboring cell pointed at by tile normal;
+				//we could only be colliding vs the tile-circle surface
+
+				T ox = obj->pos.x - (CenterX<T>(t) - (signx*t.xw()));//(ox,oy) is the vector from the tile-circle to 
+				T oy = obj->pos.y - (CenterY<T>(t) - (signy*t.yw()));//the circle's center
+		
+				T twid = t.xw()*2;
+				T trad = sqrt((T)(twid*twid + 0));//this gives us the radius of a circle centered on the tile's corner and extending to the opposite edge of the tile;
+												//note that this should be precomputed at compile-time since it's constant
+				
+				T len = sqrt(ox*ox + oy*oy);
+				T pen = (trad + obj->r) - len;
+		
+				if(0 < pen)
+				{
+
+					//note: len should NEVER be == 0, because if it is, 
+					//obj is not in a neighboring cell!
+					ox /= len;
+					oy /= len;
+
+					obj->ReportCollisionVsWorld(ox*pen, oy*pen, ox, oy, t);
+					
+					return COL_OTHER;
+				}	
+		}
+	}
+	else
+	{
+		//colliding diagonally
+		if( 0 < ((signx*oH) + (signy*oV)) ) 
+		{
+				//obj in diag neighb cell pointed at by tile normal;
+				//we could only be colliding vs the tile-circle surface
+
+				T ox = obj->pos.x - (CenterX<T>(t) - (signx*t.xw()));//(ox,oy) is the vector from the tile-circle to 
+				T oy = obj->pos.y - (CenterY<T>(t) - (signy*t.yw()));//the circle's center
+		
+				T twid = t.xw()*2;
+				T trad = sqrt((T)(twid*twid + 0));//this gives us the radius of a circle centered on the tile's corner and extending to the opposite edge of the tile;
+												//note that this should be precomputed at compile-time since it's constant
+				
+				T len = sqrt(ox*ox + oy*oy);
+				T pen = (trad + obj->r) - len;
+				
+				if(0 < pen)
+				{
+
+					//note: len should NEVER be == 0, because if it is, 
+					//obj is not in a neighboring cell!
+					ox /= len;
+					oy /= len;
+
+					obj->ReportCollisionVsWorld(ox*pen, oy*pen, ox, oy, t);
+					
+					return COL_OTHER;
+				}
+		}
+		else
+		{
+			//collide vs. vertex
+			//get diag vertex position
+			T vx = CenterX<T>(t) + (oH*t.xw());
+			T vy = CenterY<T>(t) + (oV*t.yw());
+			
+			T dx = obj->pos.x - vx;//calc vert->circle vector		
+			T dy = obj->pos.y - vy;
+			
+			T len = sqrt(dx*dx + dy*dy);
+			T pen = obj->r - len;
+			if(0 < pen)
+			{
+				//vertex is in the circle; project outward
+				if(len == 0)
+				{
+					//project out by 45deg
+					dx = oH / (T)SQRT2;
+					dy = oV / (T)SQRT2;
+				}
+				else
+				{
+					dx /= len;
+					dy /= len;
+				}
+
+				obj->ReportCollisionVsWorld(dx*pen, dy*pen, dx, dy, t);
+				
+				return COL_OTHER;
+			}
+	
+		}
+	
+	}
+
+	return COL_NONE;
+	
+}
+
+
+template<class T> template<int ID, int oH, int oV>
+int BodyT<T>::ProjCircle_22DegS(T x, T y, BodyT *obj, const TileRef &t)
+{
+	
+	//if the object is in a cell pointed at by signy, no collision will ever occur
+	//otherwise,
+	//
+	//if we're colliding diagonally:
+	//  -collide vs. the appropriate vertex
+	//if obj is in this tile: collide vs slope or vertex
+	//if obj is horiz neighb in direction of slope: collide vs. slope or vertex
+	//if obj is horiz neighb against the slope:
+	//   if(distance in y from circle to 90deg corner of tile < 1/2 tileheight, collide vs. face)
+	//   else(collide vs. corner of slope) (vert collision with a non-grid-aligned vert)
+	//if obj is vert neighb against direction of slope: collide vs. face
+
+	const int signx = EdgeSignX(ID);
+	const int signy = EdgeSignY(ID);
+
+	if(0 < (signy*oV))
+	{
+		//object will never collide vs tile, it can't reach that far
+		
+		return COL_NONE;
+	}
+	else if(oH == 0)
+	{
+		if(oV == 0)
+		{
+			//colliding with current tile
+			//we could only be colliding vs the slope OR a vertex
+			//look at the vector form the closest vert to the circle to decide
+	
+			T sx = SlopeX<T>(t);
+			T sy = SlopeY<T>(t);
+			
+			int r = obj->r;
+			T ox = obj->pos.x - (CenterX<T>(t) - (signx*t.xw()));//this gives is the coordinates of the innermost
+			T oy = obj->pos.y - CenterY<T>(t);//point on the circle, relative to the tile corner	
+		
+			//if the component of (ox,oy) parallel to the normal's righthand normal
+			//has the same sign as the slope of the slope (the sign of the slope's slope is signx*signy)
+			//then we project by the vertex, otherwise by the normal or axially.
+			//note that this is simply a VERY tricky/weird method of determining 
+			//if the circle is in side the slope/face's voronio region, or that of the vertex.
+				
+			T perp = (ox*-sy) + (oy*sx);
+			if(0 < (perp*signx*signy))
+			{
+				//collide vs. vertex
+				T len = sqrt(ox*ox + oy*oy);
+				T pen = r - len;
+				if(0 < pen)
+				{
+					//note: if len=0, then perp=0 and we'll never reach here, so don't worry about div-by-0
+					ox /= len;
+					oy /= len;
+
+					obj->ReportCollisionVsWorld(ox*pen, oy*pen, ox, oy, t);
+					
+					return COL_OTHER;
+				}					
+			}
+			else
+			{
+				//collide vs. slope or vs axis
+				ox -= r*sx;//this gives us the vector from  
+				oy -= r*sy;//a point on the slope to the innermost point on the circle
+		
+				//if the dotprod of (ox,oy) and (sx,sy) is negative, the point on the circle is in the slope
+				//and we need toproject it out by the magnitude of the projection of (ox,oy) onto (sx,sy)
+				T dp = (ox*sx) + (oy*sy);
+				
+				T lenP;
+				
+				if(dp < 0)
+				{
+					//collision; project delta onto slope and use this to displace the object
+					sx *= -dp;//(sx,sy) is now the projection vector
+					sy *= -dp;		
+						
+					T lenN = sqrt(sx*sx + sy*sy);
+			
+					//find the smallest axial projection vector
+					if(x < y)
+					{					
+						//penetration in x is smaller
+						lenP = x;
+						y = 0;	
+						//get sign for projection along x-axis		
+						if((obj->pos.x - CenterX<T>(t)) < 0)
+						{
+							x *= -1;
+						}
+					}
+					else
+					{		
+						//penetration in y is smaller
+						lenP = y;
+						x = 0;	
+						//get sign for projection along y-axis		
+						if((obj->pos.y - CenterY<T>(t))< 0)
+						{
+							y *= -1;
+						}			
+					}
+
+					if(lenP < lenN)
+					{
+						obj->ReportCollisionVsWorld(x,y,x/lenP, y/lenP, t);
+
+						return COL_AXIS;
+					}
+					else
+					{				
+						obj->ReportCollisionVsWorld(sx,sy,SlopeX<T>(t),SlopeY<T>(t),t);
+
+						return COL_OTHER;
+					}
+			
+				}
+			}
+			
+		}
+		else
+		{
+			//colliding vertically; we can assume that (signy*oV) < 0
+			//due to the first conditional far above
+
+			obj->ReportCollisionVsWorld(0,y*oV, 0, oV, t);
+				
+			return COL_AXIS;
+		}		
+	}
+	else if(oV == 0)
+	{
+		//colliding horizontally
+		if((signx*oH) < 0)
+		{
+			//colliding with face/edge OR with corner of wedge, depending on our position vertically
+				
+			//collide vs. vertex
+			//get diag vertex position
+			T vx = CenterX<T>(t) - (signx*t.xw());
+			T vy = CenterY<T>(t);
+					
+			T dx = obj->pos.x - vx;//calc vert->circle vector		
+			T dy = obj->pos.y - vy;
+					
+			if((dy*signy) < 0)
+			{
+				//colliding vs face
+				obj->ReportCollisionVsWorld(x*oH, 0, oH, 0, t);
+				
+				return COL_AXIS;					
+			}
+			else
+			{
+				//colliding vs. vertex
+					
+				T len = sqrt(dx*dx + dy*dy);
+				T pen = obj->r - len;
+				if(0 < pen)
+				{
+					//vertex is in the circle; project outward
+					if(len == 0)
+					{
+						//project out by 45deg
+						dx = oH / (T)SQRT2;
+						dy = oV / (T)SQRT2;
+					}
+					else
+					{
+						dx /= len;
+						dy /= len;
+					}
+
+					obj->ReportCollisionVsWorld(dx*pen, dy*pen, dx, dy, t);
+					
+					return COL_OTHER;
+				}
+			}
+		}
+		else
+		{
+			//we could only be colliding vs the slope OR a vertex
+			//look at the vector form the closest vert to the circle to decide
+	
+			T sx = SlopeX<T>(t);
+			T sy = SlopeY<T>(t);
+				
+			T ox = obj->pos.x - (CenterX<T>(t) + (oH*t.xw()));//this gives is the coordinates of the innermost
+			T oy = obj->pos.y - (CenterY<T>(t) - (signy*t.yw()));//point on the circle, relative to the closest tile vert	
+	
+			//if the component of (ox,oy) parallel to the normal's righthand normal
+			//has the same sign as the slope of the slope (the sign of the slope's slope is signx*signy)
+			//then we project by the normal, otherwise by the vertex.
+			//(NOTE: this is the opposite logic of the vertical case;
+			// for vertical, if the perp prod and the slope's slope agree, it's outside.
+			// for horizontal, if the perp prod and the slope's slope agree, circle is inside.
+			//  ..but this is only a property of flahs' coord system (i.e the rules might swap
+			// in righthanded systems))
+			//note that this is simply a VERY tricky/weird method of determining 
+			//if the circle is in side the slope/face's voronio region, or that of the vertex.											  
+			T perp = (ox*-sy) + (oy*sx);
+			if((perp*signx*signy) < 0)
+			{
+				//collide vs. vertex
+				T len = sqrt(ox*ox + oy*oy);
+				T pen = obj->r - len;
+				if(0 < pen)
+				{
+					//note: if len=0, then perp=0 and we'll never reach here, so don't worry about div-by-0
+					ox /= len;
+					oy /= len;
+
+					obj->ReportCollisionVsWorld(ox*pen, oy*pen, ox, oy, t);
+					
+					return COL_OTHER;
+				}					
+			}
+			else
+			{
+				//collide vs. slope
+						
+				//if the component of (ox,oy) parallel to the normal is less than the circle radius, we're
+				//penetrating the slope. note that this method of penetration calculation doesn't hold
+				//in general (i.e it won't work if the circle is in the slope), but works in this case
+				//because we know the circle is in a neighboring cell
+				T dp = (ox*sx) + (oy*sy);
+				T pen = obj->r - abs(dp);//note: we don't need the abs because we know the dp will be positive, but just in case..				
+
+				if(0 < pen)
+				{
+					//collision; circle out along normal by penetration amount
+					obj->ReportCollisionVsWorld(sx*pen, sy*pen, sx, sy, t);
+					
+					return COL_OTHER;
+				}
+			}
+		}
+	}
+	else
+	{
+
+		//colliding diagonally; due to the first conditional above,
+		//obj is vertically offset against slope, and offset in either direction horizontally
+
+		//collide vs. vertex
+		//get diag vertex position
+		T vx = CenterX<T>(t) + (oH*t.xw());
+		T vy = CenterY<T>(t) + (oV*t.yw());
+			
+		T dx = obj->pos.x - vx;//calc vert->circle vector		
+		T dy = obj->pos.y - vy;
+			
+		T len = sqrt(dx*dx + dy*dy);
+		T pen = obj->r - len;
+		if(0 < pen)
+		{
+			//vertex is in the circle; project outward
+			if(len == 0)
+			{
+				//project out by 45deg
+				dx = oH / (T)SQRT2;
+				dy = oV / (T)SQRT2;
+			}
+			else
+			{
+				dx /= len;
+				dy /= len;
+			}
+
+			obj->ReportCollisionVsWorld(dx*pen, dy*pen, dx, dy, t);
+			
+			return COL_OTHER;
+		}
+	}
+
+	return COL_NONE;
+
+}
+
+
+template<class T> template<int ID, int oH, int oV>
+int BodyT<T>::ProjCircle_22DegB(T x, T y, BodyT *obj, const TileRef &t)
+{
+
+	//if we're colliding diagonally:
+	//  -if we're in the cell pointed at by the normal, collide vs slope, else
+	//  collide vs. the appropriate corner/vertex
+	//
+	//if obj is in this tile: collide as with aabb
+	//
+	//if obj is horiz or vertical neighbor AGAINST the slope: collide with edge
+	//
+	//if obj is horiz neighb in direction of slope: collide vs. slope or vertex or edge
+	//
+	//if obj is vert neighb in direction of slope: collide vs. slope or vertex
+
+	const int signx = EdgeSignX(ID);
+	const int signy = EdgeSignY(ID);
+
+	if(oH == 0)
+	{
+		if(oV == 0)
+		{
+			//colliding with current cell
+
+			T sx = SlopeX<T>(t);
+			T sy = SlopeY<T>(t);
+			
+			T lenP;
+	
+			int r = obj->r;
+			T ox = (obj->pos.x - (sx*r)) - (CenterX<T>(t) - (signx*t.xw()));//this gives is the coordinates of the innermost
+			T oy = (obj->pos.y - (sy*r)) - (CenterY<T>(t) + (signy*t.yw()));//point on the AABB, relative to a point on the slope
+		
+			//if the dotprod of (ox,oy) and (sx,sy) is negative, the point on the circle is in the slope
+			//and we need toproject it out by the magnitude of the projection of (ox,oy) onto (sx,sy)
+			T dp = (ox*sx) + (oy*sy);
+					
+			if(dp < 0)
+			{
+				//collision; project delta onto slope and use this to displace the object
+				sx *= -dp;//(sx,sy) is now the projection vector
+				sy *= -dp;		
+							
+				T lenN = sqrt(sx*sx + sy*sy);
+				
+				//find the smallest axial projection vector
+				if(x < y)
+				{					
+					//penetration in x is smaller
+					lenP = x;
+					y = 0;	
+					//get sign for projection along x-axis		
+					if((obj->pos.x - CenterX<T>(t)) < 0)
+					{
+						x *= -1;
+					}
+				}
+				else
+				{		
+					//penetration in y is smaller
+					lenP = y;
+					x = 0;	
+					//get sign for projection along y-axis		
+					if((obj->pos.y - CenterY<T>(t))< 0)
+					{
+						y *= -1;
+					}			
+				}
+	
+				if(lenP < lenN)
+				{
+					obj->ReportCollisionVsWorld(x, y, x/lenP, y/lenP, t);
+					
+					return COL_AXIS;
+				}
+				else
+				{			
+					obj->ReportCollisionVsWorld(sx, sy, SlopeX<T>(t), SlopeY<T>(t), t);
+			
+					return COL_OTHER;
+				}	
+			}					
+		}
+		else
+		{
+			//colliding vertically
+			
+			if((signy*oV) < 0)
+			{
+				//colliding with face/edge
+				obj->ReportCollisionVsWorld(0, y*oV, 0, oV, t);
+				
+				return COL_AXIS;
+			}
+			else
+			{
+				//we could only be colliding vs the slope OR a vertex
+				//look at the vector form the closest vert to the circle to decide
+
+				T sx = SlopeX<T>(t);
+				T sy = SlopeY<T>(t);
+				
+				T ox = obj->pos.x - (CenterX<T>(t) - (signx*t.xw()));//this gives is the coordinates of the innermost
+				T oy = obj->pos.y - (CenterY<T>(t) + (signy*t.yw()));//point on the circle, relative to the closest tile vert	
+
+				//if the component of (ox,oy) parallel to the normal's righthand normal
+				//has the same sign as the slope of the slope (the sign of the slope's slope is signx*signy)
+				//then we project by the vertex, otherwise by the normal.
+				//note that this is simply a VERY tricky/weird method of determining 
+				//if the circle is in side the slope/face's voronio region, or that of the vertex.											  
+				T perp = (ox*-sy) + (oy*sx);
+				if(0 < (perp*signx*signy))
+				{
+					//collide vs. vertex
+					T len = sqrt(ox*ox + oy*oy);
+					T pen = obj->r - len;
+					if(0 < pen)
+					{
+						//note: if len=0, then perp=0 and we'll never reach here, so don't worry about div-by-0
+						ox /= len;
+						oy /= len;
+
+						obj->ReportCollisionVsWorld(ox*pen, oy*pen, ox, oy, t);
+						
+						return COL_OTHER;
+					}					
+				}
+				else
+				{
+					//collide vs. slope
+					
+					//if the component of (ox,oy) parallel to the normal is less than the circle radius, we're
+					//penetrating the slope. note that this method of penetration calculation doesn't hold
+					//in general (i.e it won't work if the circle is in the slope), but works in this case
+					//because we know the circle is in a neighboring cell
+					T dp = (ox*sx) + (oy*sy);
+					T pen = obj->r - abs(dp);//note: we don't need the abs because we know the dp will be positive, but just in case..
+					if(0 < pen)
+					{
+						//collision; circle out along normal by penetration amount
+						obj->ReportCollisionVsWorld(sx*pen, sy*pen,sx, sy, t);
+						
+						return COL_OTHER;
+					}
+				}
+			}
+		}
+	}
+	else if(oV == 0)
+	{
+		//colliding horizontally
+		
+		if((signx*oH) < 0)
+		{
+			//colliding with face/edge
+			obj->ReportCollisionVsWorld(x*oH, 0, oH, 0, t);
+			
+			return COL_AXIS;
+		}
+		else
+		{
+			//colliding with edge, slope, or vertex
+		
+			T ox = obj->pos.x - (CenterX<T>(t) + (signx*t.xw()));//this gives is the coordinates of the innermost
+			T oy = obj->pos.y - CenterY<T>(t);//point on the circle, relative to the closest tile vert	
+				
+			if((oy*signy) < 0)
+			{
+				//we're colliding with the halfface
+				obj->ReportCollisionVsWorld(x*oH, 0, oH, 0, t);
+				
+				return COL_AXIS;			
+			}
+			else
+			{
+				//colliding with the vertex or slope
+
+				T sx = SlopeX<T>(t);
+				T sy = SlopeY<T>(t);
+								
+				//if the component of (ox,oy) parallel to the normal's righthand normal
+				//has the same sign as the slope of the slope (the sign of the slope's slope is signx*signy)
+				//then we project by the slope, otherwise by the vertex.
+				//note that this is simply a VERY tricky/weird method of determining 
+				//if the circle is in side the slope/face's voronio region, or that of the vertex.											  
+				T perp = (ox*-sy) + (oy*sx);
+				if((perp*signx*signy) < 0)
+				{
+					//collide vs. vertex
+					T len = sqrt(ox*ox + oy*oy);
+					T pen = obj->r - len;
+					if(0 < pen)
+					{
+						//note: if len=0, then perp=0 and we'll never reach here, so don't worry about div-by-0
+						ox /= len;
+						oy /= len;
+	
+						obj->ReportCollisionVsWorld(ox*pen, oy*pen, ox, oy, t);
+						
+						return COL_OTHER;
+					}					
+				}
+				else
+				{
+					//collide vs. slope
+						
+					//if the component of (ox,oy) parallel to the normal is less than the circle radius, we're
+					//penetrating the slope. note that this method of penetration calculation doesn't hold
+					//in general (i.e it won't work if the circle is in the slope), but works in this case
+					//because we know the circle is in a neighboring cell
+					T dp = (ox*sx) + (oy*sy);
+					T pen = obj->r - abs(dp);//note: we don't need the abs because we know the dp will be positive, but just in case..
+					if(0 < pen)
+					{
+						//collision; circle out along normal by penetration amount
+						obj->ReportCollisionVsWorld(sx*pen, sy*pen, SlopeX<T>(t), SlopeY<T>(t), t);
+						
+						return COL_OTHER;
+					}
+				}	
+			}
+		}
+	}
+	else
+	{
+		//colliding diagonally
+		if( 0 < ((signx*oH) + (signy*oV)) ) 
+		{
+			//the dotprod of slope normal and cell offset is strictly positive,
+			//therefore obj is in the diagonal neighb pointed at by the normal.
+			
+			//collide vs slope
+
+			//we should really precalc this at compile time, but for now, fuck it
+			T slen = sqrt((T)(2*2 + 1*1));//the raw slope is (-2,-1)
+			T sx = (signx*1) / slen;//get slope _unit_ normal;
+			T sy = (signy*2) / slen;//raw RH normal is (1,-2)
+	
+			int r = obj->r;
+			T ox = (obj->pos.x - (sx*r)) - (CenterX<T>(t) - (signx*t.xw()));//this gives is the coordinates of the innermost
+			T oy = (obj->pos.y - (sy*r)) - (CenterY<T>(t) + (signy*t.yw()));//point on the circle, relative to a point on the slope
+		
+			//if the dotprod of (ox,oy) and (sx,sy) is negative, the point on the circle is in the slope
+			//and we need toproject it out by the magnitude of the projection of (ox,oy) onto (sx,sy)
+			T dp = (ox*sx) + (oy*sy);
+					
+			if(dp < 0)
+			{
+				//collision; project delta onto slope and use this to displace the object	
+				//(sx,sy)*-dp is the projection vector
+				obj->ReportCollisionVsWorld(-sx*dp, -sy*dp, SlopeX<T>(t), SlopeY<T>(t), t);
+				
+				return COL_OTHER;
+			}
+			return COL_NONE;
+		}
+		else
+		{
+			//collide vs the appropriate vertex
+			T vx = CenterX<T>(t) + (oH*t.xw());
+			T vy = CenterY<T>(t) + (oV*t.yw());
+			
+			T dx = obj->pos.x - vx;//calc vert->circle vector		
+			T dy = obj->pos.y - vy;
+			
+			T len = sqrt(dx*dx + dy*dy);
+			T pen = obj->r - len;
+			if(0 < pen)
+			{
+				//vertex is in the circle; project outward
+				if(len == 0)
+				{
+					//project out by 45deg
+					dx = oH / (T)SQRT2;
+					dy = oV / (T)SQRT2;
+				}
+				else
+				{
+					dx /= len;
+					dy /= len;
+				}
+
+				obj->ReportCollisionVsWorld(dx*pen, dy*pen, dx, dy, t);
+
+				return COL_OTHER;
+			}
+				
+		}		
+	}
+	
+	return COL_NONE;
+}
+
+
+template<class T> template<int ID, int oH, int oV>
+int BodyT<T>::ProjCircle_67DegS(T x, T y, BodyT *obj, const TileRef &t)
+{
+	//if the object is in a cell pointed at by signx, no collision will ever occur
+	//otherwise,
+	//
+	//if we're colliding diagonally:
+	//  -collide vs. the appropriate vertex
+	//if obj is in this tile: collide vs slope or vertex or axis
+	//if obj is vert neighb in direction of slope: collide vs. slope or vertex
+	//if obj is vert neighb against the slope:
+	//   if(distance in y from circle to 90deg corner of tile < 1/2 tileheight, collide vs. face)
+	//   else(collide vs. corner of slope) (vert collision with a non-grid-aligned vert)
+	//if obj is horiz neighb against direction of slope: collide vs. face
+
+	const int signx = EdgeSignX(ID);
+	const int signy = EdgeSignY(ID);
+
+	if(0 < (signx*oH))
+	{
+		//object will never collide vs tile, it can't reach that far
+
+		return COL_NONE;
+	}
+	else if(oH == 0)
+	{
+		if(oV == 0)
+		{
+			//colliding with current tile
+			//we could only be colliding vs the slope OR a vertex
+			//look at the vector form the closest vert to the circle to decide
+	
+			T sx = SlopeX<T>(t);
+			T sy = SlopeY<T>(t);
+			
+			int r = obj->r;
+			T ox = obj->pos.x - CenterX<T>(t);//this gives is the coordinates of the innermost
+			T oy = obj->pos.y - (CenterY<T>(t) - (signy*t.yw()));//point on the circle, relative to the tile corner	
+		
+			//if the component of (ox,oy) parallel to the normal's righthand normal
+			//has the same sign as the slope of the slope (the sign of the slope's slope is signx*signy)
+			//then we project by the normal or axis, otherwise by the corner/vertex
+			//note that this is simply a VERY tricky/weird method of determining 
+			//if the circle is in side the slope/face's voronoi region, or that of the vertex.
+				
+			T perp = (ox*-sy) + (oy*sx);
+			if((perp*signx*signy) < 0)
+			{
+				//collide vs. vertex
+				T len = sqrt(ox*ox + oy*oy);
+				T pen = r - len;
+				if(0 < pen)
+				{
+					//note: if len=0, then perp=0 and we'll never reach here, so don't worry about div-by-0
+					ox /= len;
+					oy /= len;
+
+					obj->ReportCollisionVsWorld(ox*pen, oy*pen, ox, oy, t);
+					return COL_OTHER;
+				}					
+			}
+			else
+			{
+				//collide vs. slope or vs axis
+				ox -= r*sx;//this gives us the vector from  
+				oy -= r*sy;//a point on the slope to the innermost point on the circle
+				
+				T lenP;
+		
+				//if the dotprod of (ox,oy) and (sx,sy) is negative, the point on the circle is in the slope
+				//and we need toproject it out by the magnitude of the projection of (ox,oy) onto (sx,sy)
+				T dp = (ox*sx) + (oy*sy);
+				
+				if(dp < 0)
+				{
+					//collision; project delta onto slope and use this to displace the object
+					sx *= -dp;//(sx,sy) is now the projection vector
+					sy *= -dp;		
+						
+					T lenN = sqrt(sx*sx + sy*sy);
+			
+					//find the smallest axial projection vector
+					if(x < y)
+					{					
+						//penetration in x is smaller
+						lenP = x;
+						y = 0;	
+						//get sign for projection along x-axis		
+						if((obj->pos.x - CenterX<T>(t)) < 0)
+						{
+							x *= -1;
+						}
+					}
+					else
+					{		
+						//penetration in y is smaller
+						lenP = y;
+						x = 0;	
+						//get sign for projection along y-axis		
+						if((obj->pos.y - CenterY<T>(t))< 0)
+						{
+							y *= -1;
+						}			
+					}
+
+					if(lenP < lenN)
+					{
+						obj->ReportCollisionVsWorld(x,y,x/lenP, y/lenP, t);
+						
+						return COL_AXIS;
+					}
+					else
+					{		
+						obj->ReportCollisionVsWorld(sx,sy,SlopeX<T>(t),SlopeY<T>(t),t);
+						
+						return COL_OTHER;
+					}	
+				}
+			}
+			
+		}
+		else
+		{
+			//colliding vertically
+			
+			if((signy*oV) < 0)
+			{
+				//colliding with face/edge OR with corner of wedge, depending on our position vertically
+					
+				//collide vs. vertex
+				//get diag vertex position
+				T vx = CenterX<T>(t);
+				T vy = CenterY<T>(t) - (signy*t.yw());
+						
+				T dx = obj->pos.x - vx;//calc vert->circle vector		
+				T dy = obj->pos.y - vy;
+						
+				if((dx*signx) < 0)
+				{	
+					//colliding vs face
+					obj->ReportCollisionVsWorld(0, y*oV, 0, oV, t);
+					
+					return COL_AXIS;					
+				}
+				else
+				{
+					//colliding vs. vertex
+						
+					T len = sqrt(dx*dx + dy*dy);
+					T pen = obj->r - len;
+					if(0 < pen)
+					{
+						//vertex is in the circle; project outward
+						if(len == 0)
+						{
+							//project out by 45deg
+							dx = oH / (T)SQRT2;
+							dy = oV / (T)SQRT2;
+						}
+						else
+						{
+							dx /= len;
+							dy /= len;
+						}
+							
+						obj->ReportCollisionVsWorld(dx*pen, dy*pen, dx, dy, t);
+						
+						return COL_OTHER;
+					}
+				}
+			}
+			else
+			{
+				//we could only be colliding vs the slope OR a vertex
+				//look at the vector form the closest vert to the circle to decide
+		
+				T sx = SlopeX<T>(t);
+				T sy = SlopeY<T>(t);
+					
+				T ox = obj->pos.x - (CenterX<T>(t) - (signx*t.xw()));//this gives is the coordinates of the innermost
+				T oy = obj->pos.y - (CenterY<T>(t) + (oV*t.yw()));//point on the circle, relative to the closest tile vert	
+		
+				//if the component of (ox,oy) parallel to the normal's righthand normal
+				//has the same sign as the slope of the slope (the sign of the slope's slope is signx*signy)
+				//then we project by the vertex, otherwise by the normal.
+				//note that this is simply a VERY tricky/weird method of determining 
+				//if the circle is in side the slope/face's voronio region, or that of the vertex.											  
+				T perp = (ox*-sy) + (oy*sx);
+				if(0 < (perp*signx*signy))
+				{
+					//collide vs. vertex
+					T len = sqrt(ox*ox + oy*oy);
+					T pen = obj->r - len;
+					if(0 < pen)
+					{
+						//note: if len=0, then perp=0 and we'll never reach here, so don't worry about div-by-0
+						ox /= len;
+						oy /= len;
+
+						obj->ReportCollisionVsWorld(ox*pen, oy*pen, ox, oy, t);
+						
+						return COL_OTHER;
+					}					
+				}
+				else
+				{
+					//collide vs. slope
+							
+					//if the component of (ox,oy) parallel to the normal is less than the circle radius, we're
+					//penetrating the slope. note that this method of penetration calculation doesn't hold
+					//in general (i.e it won't work if the circle is in the slope), but works in this case
+					//because we know the circle is in a neighboring cell
+					T dp = (ox*sx) + (oy*sy);
+					T pen = obj->r - abs(dp);//note: we don't need the abs because we know the dp will be positive, but just in case..				
+
+					if(0 < pen)
+					{
+						//collision; circle out along normal by penetration amount
+						obj->ReportCollisionVsWorld(sx*pen, sy*pen, SlopeX<T>(t), SlopeY<T>(t), t);
+						
+						return COL_OTHER;
+					}
+				}
+			}
+		}		
+	}
+	else if(oV == 0)
+	{
+		//colliding horizontally; we can assume that (signy*oV) < 0
+		//due to the first conditional far above
+
+			obj->ReportCollisionVsWorld(x*oH, 0, oH, 0, t);
+			
+			return COL_AXIS;
+	}
+	else
+	{		
+		//colliding diagonally; due to the first conditional above,
+		//obj is vertically offset against slope, and offset in either direction horizontally
+
+		//collide vs. vertex
+		//get diag vertex position
+		T vx = CenterX<T>(t) + (oH*t.xw());
+		T vy = CenterY<T>(t) + (oV*t.yw());
+			
+		T dx = obj->pos.x - vx;//calc vert->circle vector		
+		T dy = obj->pos.y - vy;
+			
+		T len = sqrt(dx*dx + dy*dy);
+		T pen = obj->r - len;
+		if(0 < pen)
+		{
+			//vertex is in the circle; project outward
+			if(len == 0)
+			{
+				//project out by 45deg
+				dx = oH / (T)SQRT2;
+				dy = oV / (T)SQRT2;
+			}
+			else
+			{
+				dx /= len;
+				dy /= len;
+			}
+
+			obj->ReportCollisionVsWorld(dx*pen, dy*pen, dx, dy, t);
+			
+			return COL_OTHER;
+		}
+	}
+
+	return COL_NONE;
+
+}
+
+
+template<class T> template<int ID, int oH, int oV>
+int BodyT<T>::ProjCircle_67DegB(T x, T y, BodyT *obj, const TileRef &t)
+{
+	//if we're colliding diagonally:
+	//  -if we're in the cell pointed at by the normal, collide vs slope, else
+	//  collide vs. the appropriate corner/vertex
+	//
+	//if obj is in this tile: collide as with aabb
+	//
+	//if obj is horiz or vertical neighbor AGAINST the slope: collide with edge
+	//
+	//if obj is vert neighb in direction of slope: collide vs. slope or vertex or halfedge
+	//
+	//if obj is horiz neighb in direction of slope: collide vs. slope or vertex
+
+	const int signx = EdgeSignX(ID);
+	const int signy = EdgeSignY(ID);
+
+	if(oH == 0)
+	{
+		if(oV == 0)
+		{
+			//colliding with current cell
+
+			T sx = SlopeX<T>(t);
+			T sy = SlopeY<T>(t);
+			
+			T lenP;
+	
+			int r = obj->r;
+			T ox = (obj->pos.x - (sx*r)) - (CenterX<T>(t) + (signx*t.xw()));//this gives is the coordinates of the innermost
+			T oy = (obj->pos.y - (sy*r)) - (CenterY<T>(t) - (signy*t.yw()));//point on the AABB, relative to a point on the slope
+		
+			//if the dotprod of (ox,oy) and (sx,sy) is negative, the point on the circle is in the slope
+			//and we need toproject it out by the magnitude of the projection of (ox,oy) onto (sx,sy)
+			T dp = (ox*sx) + (oy*sy);
+					
+			if(dp < 0)
+			{
+				//collision; project delta onto slope and use this to displace the object
+				sx *= -dp;//(sx,sy) is now the projection vector
+				sy *= -dp;		
+							
+				T lenN = sqrt(sx*sx + sy*sy);
+				
+				//find the smallest axial projection vector
+				if(x < y)
+				{					
+					//penetration in x is smaller
+					lenP = x;
+					y = 0;	
+					//get sign for projection along x-axis		
+					if((obj->pos.x - CenterX<T>(t)) < 0)
+					{
+						x *= -1;
+					}
+				}
+				else
+				{		
+					//penetration in y is smaller
+					lenP = y;
+					x = 0;	
+					//get sign for projection along y-axis		
+					if((obj->pos.y - CenterY<T>(t))< 0)
+					{
+						y *= -1;
+					}			
+				}
+	
+				if(lenP < lenN)
+				{
+					obj->ReportCollisionVsWorld(x,y,x/lenP, y/lenP, t);
+					
+					return COL_AXIS;
+				}
+				else
+				{
+					obj->ReportCollisionVsWorld(sx, sy, SlopeX<T>(t), SlopeY<T>(t), t);
+					
+					return COL_OTHER;
+				}
+	
+			}					
+		}
+		else
+		{
+			//colliding vertically
+		
+			if((signy*oV) < 0)
+			{
+				//colliding with face/edge
+				obj->ReportCollisionVsWorld(0, y*oV, 0, oV, t);
+
+				return COL_AXIS;
+			}
+			else
+			{
+				//colliding with edge, slope, or vertex
+			
+				T ox = obj->pos.x - CenterX<T>(t);//this gives is the coordinates of the innermost
+				T oy = obj->pos.y - (CenterY<T>(t) + (signy*t.yw()));//point on the circle, relative to the closest tile vert	
+					
+				if((ox*signx) < 0)
+				{
+					//we're colliding with the halfface
+					obj->ReportCollisionVsWorld(0, y*oV, 0, oV, t);
+
+					return COL_AXIS;			
+				}
+				else
+				{
+					//colliding with the vertex or slope
+
+					T sx = SlopeX<T>(t);
+					T sy = SlopeY<T>(t);
+									
+					//if the component of (ox,oy) parallel to the normal's righthand normal
+					//has the same sign as the slope of the slope (the sign of the slope's slope is signx*signy)
+					//then we project by the vertex, otherwise by the slope.
+					//note that this is simply a VERY tricky/weird method of determining 
+					//if the circle is in side the slope/face's voronio region, or that of the vertex.											  
+					T perp = (ox*-sy) + (oy*sx);
+					if(0 < (perp*signx*signy))
+					{
+						//collide vs. vertex
+						T len = sqrt(ox*ox + oy*oy);
+						T pen = obj->r - len;
+						if(0 < pen)
+						{
+							//note: if len=0, then perp=0 and we'll never reach here, so don't worry about div-by-0
+							ox /= len;
+							oy /= len;
+		
+							obj->ReportCollisionVsWorld(ox*pen, oy*pen, ox, oy, t);
+							
+							return COL_OTHER;
+						}					
+					}
+					else
+					{
+						//collide vs. slope
+							
+						//if the component of (ox,oy) parallel to the normal is less than the circle radius, we're
+						//penetrating the slope. note that this method of penetration calculation doesn't hold
+						//in general (i.e it won't work if the circle is in the slope), but works in this case
+						//because we know the circle is in a neighboring cell
+						T dp = (ox*sx) + (oy*sy);
+						T pen = obj->r - abs(dp);//note: we don't need the abs because we know the dp will be positive, but just in case..
+						if(0 < pen)
+						{
+							//collision; circle out along normal by penetration amount
+							obj->ReportCollisionVsWorld(sx*pen, sy*pen, sx, sy, t);
+							
+							return COL_OTHER;
+						}
+					}	
+				}
+			}
+		}
+	}
+	else if(oV == 0)
+	{
+		//colliding horizontally
+			
+		if((signx*oH) < 0)
+		{
+			//colliding with face/edge
+			obj->ReportCollisionVsWorld(x*oH, 0, oH, 0, t);
+			
+			return COL_AXIS;
+		}
+		else
+		{
+			//we could only be colliding vs the slope OR a vertex
+			//look at the vector form the closest vert to the circle to decide
+
+			T slen = sqrt((T)(2*2 + 1*1));//the raw slope is (-2,-1)
+			T sx = (signx*2) / slen;//get slope _unit_ normal;
+			T sy = (signy*1) / slen;//raw RH normal is (1,-2)
+				
+			T ox = obj->pos.x - (CenterX<T>(t) + (signx*t.xw()));//this gives is the coordinates of the innermost
+			T oy = obj->pos.y - (CenterY<T>(t) - (signy*t.yw()));//point on the circle, relative to the closest tile vert	
+
+			//if the component of (ox,oy) parallel to the normal's righthand normal
+			//has the same sign as the slope of the slope (the sign of the slope's slope is signx*signy)
+			//then we project by the slope, otherwise by the vertex.
+			//note that this is simply a VERY tricky/weird method of determining 
+			//if the circle is in side the slope/face's voronio region, or that of the vertex.											  
+			T perp = (ox*-sy) + (oy*sx);
+			if((perp*signx*signy) < 0)
+			{
+				//collide vs. vertex
+				T len = sqrt(ox*ox + oy*oy);
+				T pen = obj->r - len;
+				if(0 < pen)
+				{
+					//note: if len=0, then perp=0 and we'll never reach here, so don't worry about div-by-0
+					ox /= len;
+					oy /= len;
+
+					obj->ReportCollisionVsWorld(ox*pen, oy*pen, ox, oy, t);
+					
+					return COL_OTHER;
+				}					
+			}
+			else
+			{
+				//collide vs. slope
+					
+				//if the component of (ox,oy) parallel to the normal is less than the circle radius, we're
+				//penetrating the slope. note that this method of penetration calculation doesn't hold
+				//in general (i.e it won't work if the circle is in the slope), but works in this case
+				//because we know the circle is in a neighboring cell
+				T dp = (ox*sx) + (oy*sy);
+				T pen = obj->r - abs(dp);//note: we don't need the abs because we know the dp will be positive, but just in case..
+				if(0 < pen)
+				{
+					//collision; circle out along normal by penetration amount
+					obj->ReportCollisionVsWorld(sx*pen, sy*pen, SlopeX<T>(t), SlopeY<T>(t), t);
+					
+					return COL_OTHER;
+				}
+			}
+		}
+	}
+	else
+	{
+		//colliding diagonally
+		if( 0 < ((signx*oH) + (signy*oV)) ) 
+		{
+			//the dotprod of slope normal and cell offset is strictly positive,
+			//therefore obj is in the diagonal neighb pointed at by the normal.
+			
+			//collide vs slope
+
+			T sx = SlopeX<T>(t);
+			T sy = SlopeY<T>(t);
+	
+			int r = obj->r;
+			T ox = (obj->pos.x - (sx*r)) - (CenterX<T>(t) + (signx*t.xw()));//this gives is the coordinates of the innermost
+			T oy = (obj->pos.y - (sy*r)) - (CenterY<T>(t) - (signy*t.yw()));//point on the circle, relative to a point on the slope
+		
+			//if the dotprod of (ox,oy) and (sx,sy) is negative, the point on the circle is in the slope
+			//and we need toproject it out by the magnitude of the projection of (ox,oy) onto (sx,sy)
+			T dp = (ox*sx) + (oy*sy);
+					
+			if(dp < 0)
+			{
+				//collision; project delta onto slope and use this to displace the object	
+				//(sx,sy)*-dp is the projection vector
+
+				obj->ReportCollisionVsWorld(-sx*dp, -sy*dp, SlopeX<T>(t), SlopeY<T>(t), t);
+
+				return COL_OTHER;
+			}
+			return COL_NONE;
+		}
+		else
+		{
+			
+			//collide vs the appropriate vertex
+			T vx = CenterX<T>(t) + (oH*t.xw());
+			T vy = CenterY<T>(t) + (oV*t.yw());
+			
+			T dx = obj->pos.x - vx;//calc vert->circle vector		
+			T dy = obj->pos.y - vy;
+			
+			T len = sqrt(dx*dx + dy*dy);
+			T pen = obj->r - len;
+			if(0 < pen)
+			{
+				//vertex is in the circle; project outward
+				if(len == 0)
+				{
+					//project out by 45deg
+					dx = oH / (T)SQRT2;
+					dy = oV / (T)SQRT2;
+				}
+				else
+				{
+					dx /= len;
+					dy /= len;
+				}
+
+				obj->ReportCollisionVsWorld(dx*pen, dy*pen, dx, dy, t);
+
+				return COL_OTHER;
+			}
+				
+		}		
+	}
+	
+	return COL_NONE;
+}
+
+
+template class BodyT< double >;
+template class BodyT< float >;
+template class BodyT< Fixed >;
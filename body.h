@@ -0,0 +1,137 @@
+/* body.h */
+
+#ifndef BODY_H
+#define BODY_H
+
+#include <cmath>
+#include "vector2.h"
+#include "fixed.h"
+
+//these are used to report which type of collision was resolved
+enum COLLISION_RESOLVE {
+	COL_NONE = 0,//no collision was found/resolved
+	COL_AXIS = 1,//collision was resolved along the x or y axis..
+	COL_OTHER = 2//tile-specific axis was used to repolve collision (i.e slope normal, etc.)
+};
+
+//basically, these flags are uysed to indicate if an object has been moved.
+//COL_NONE means that it hasn't been moved.
+//COL_AXIS means that it has been moved so that it is no longer colliding with
+//one of the cell edges it was previously colliding with
+//COL_OTHER means it has been moved, but we don't know how (i.e it might still
+//be colliding with cell edges)
+
+//int OTYPE_CIRCLE = 1;
+
+const double GRAV = 0.0;//.3 is a bit much, .1 is a bit "on the moon"..
+const double DRAG = 0.999999;//0 means full drag, 1 is no drag
+const double BOUNCE = 1;//must be in [0,1], where 1 means full bounce. but 1 seems to incite "the flubber effect" so use 0.9 as a practical upper bound
+const double FRICTION = 0.00;
+
+const double SQRT2 = sqrt(2.0);
+
+const double SWEEP_SKIN = 0.01;//swept contacts are placed this far into the surface, so the discrete test sees them
+const int SWEEP_MAX = 4;//most contacts resolved along one step's motion
+
+class TileRef;
+class TileGrid;
+class WorldListener;
+class CollisionBuffer;
+
+//a Body is a circle as the physics sees it; no widget, no sound, no painting.
+//anything that has to happen outside the simulation (repaint, sfx, game over)
+//is reported to the listener, which may be NULL when running headless.
+//
+//in a World, collisions aren't acted on as they're found: they're recorded in
+//the World's CollisionBuffer (collisions below), and the tiles take their hits
+//and the listener hears about them once the step is done (see World::Step()).
+//so does a body's death.
+//
+//the physics is templated on the scalar type T; Body (double) is what the game
+//and World use by default, BodyF (float) is for games where halving the width
+//of every number matters more than the last bits of precision (see
+//World::single, and bench_precision.cpp for what it costs), and BodyFixed
+//(Fixed, see fixed.h) for worlds that have to play out the same on every
+//machine (see World::fixed). all three are compiled in body.cpp. the listener
+//is always given a Body; the others are told about as a double copy of
+//themselves.
+//
+//only the one-body-at-a-time code is templated (and the Broadphase's pairs).
+//BodySet and Broadphase keep their bodies in double between steps, so a World
+//in float gets none of the wider SIMD lanes or the halved memory traffic a
+//float BodySet would, and pays for converting every body in and out of float
+//twice a step; bench_precision.cpp measures how that comes out.
+template<class T> class BodyT
+{
+
+private:
+
+
+public:
+
+	int OTYPE;
+
+	Vector2T< T > pos;
+	Vector2T< T > oldpos;
+	int r;
+	
+	int dead;//set once the body falls out of the map; World::Step() leaves dead bodies alone
+	int id;//index of this body in its World's BodySet, or -1
+
+	WorldListener *listener;
+	CollisionBuffer *collisions;//if set, collisions and the body's death are recorded here instead of hitting the tile and telling the listener; may be NULL
+
+	BodyT(const Vector2T< T > &pos_in, const int &r_in);
+	template<class U> explicit BodyT(const BodyT< U > &b);//a copy in another precision
+	~BodyT() { }
+
+	void ReportCollisionVsWorld(const Vector2T< T > &p, const Vector2T< T > &n, const TileRef &obj);
+	void Die();
+	inline void ReportCollisionVsWorld(const T &px, const T &py, const T &dx, const T &dy, const TileRef &obj) { ReportCollisionVsWorld(Vector2T< T >(px, py), Vector2T< T >(dx, dy), obj); }
+	void IntegrateVerlet();
+	void CollideCirclevsTileMap( const TileRef &c );
+	TileRef Cell( TileGrid *tiles ) const;
+	void SweepCirclevsTileMap( TileGrid *tiles );
+	T SweepTimeOfImpact( TileGrid *tiles, const Vector2T< T > &from, const Vector2T< T > &to );
+
+	void CollideCirclevsPad    ( const int &padx, const int &pady, const int &padw, const TileRef &c );
+
+	int ResolveCircleTile(const T &x, const T &y, const int &oH, const int &oV, BodyT *obj, const TileRef &t);
+
+	//the tile-specific collision kernels; each is compiled once per tile ID and
+	//cell offset (oH,oV), and picked from a table by ResolveCircleTile()
+	template<int ID, int oH, int oV> int ProjCircle_Full(T x, T y, BodyT *obj, const TileRef &t);
+	template<int ID, int oH, int oV> int ProjCircle_45Deg(T x, T y, BodyT *obj, const TileRef &t);
+	template<int ID, int oH, int oV> int ProjCircle_Concave(T x, T y, BodyT *obj, const TileRef &t);
+	template<int ID, int oH, int oV> int ProjCircle_Convex(T x, T y, BodyT *obj, const TileRef &t);
+	template<int ID, int oH, int oV> int ProjCircle_22DegS(T x, T y, BodyT *obj, const TileRef &t);
+	template<int ID, int oH, int oV> int ProjCircle_22DegB(T x, T y, BodyT *obj, const TileRef &t);
+	template<int ID, int oH, int oV> int ProjCircle_67DegS(T x, T y, BodyT *obj, const TileRef &t);
+	template<int ID, int oH, int oV> int ProjCircle_67DegB(T x, T y, BodyT *obj, const TileRef &t);
+	template<int ID, int oH, int oV> int ProjCircle_Half(T x, T y, BodyT *obj, const TileRef &t);
+
+};
+
+typedef BodyT< double > Body;
+typedef BodyT< float > BodyF;
+typedef BodyT< Fixed > BodyFixed;
+
+template<> TileRef BodyT< Fixed >::Cell( TileGrid *tiles ) const;//exact, in body.cpp
+
+extern template class BodyT< double >;
+extern template class BodyT< float >;
+extern template class BodyT< Fixed >;
+
+//copies b, converting its position to T
+template<class T> template<class U> BodyT<T>::BodyT(const BodyT< U > &b)
+	: pos(b.pos), oldpos(b.oldpos)
+{
+	OTYPE = b.OTYPE;
+	r = b.r;
+	dead = b.dead;
+	id = b.id;
+	listener = b.listener;
+	collisions = b.collisions;
+}
+
+#endif //BODY_H
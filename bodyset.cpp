@@ -0,0 +1,138 @@
+//* bodyset.cpp *//
+
+#include <cstdlib>
+
+#include "body.h"
+#include "vector2x.h"
+#include "bodyset.h"
+
+using namespace std;
+
+//adds a body at rest at pos_in, and returns its index
+int BodySet::Add(Vector2 pos_in, const int &r_in)
+{
+	x.push_back( pos_in.x );
+	y.push_back( pos_in.y );
+	ox.push_back( pos_in.x );
+	oy.push_back( pos_in.y );
+	r.push_back( abs(r_in) );
+	alive.push_back( -1 );
+	return Count() - 1;
+}
+
+void BodySet::Clear()
+{
+	x.clear();
+	y.clear();
+	ox.clear();
+	oy.clear();
+	r.clear();
+	alive.clear();
+}
+
+//teleports body k; its velocity is (pos_in - oldpos_in)
+void BodySet::Place(const int &k, const Vector2 &pos_in, const Vector2 &oldpos_in)
+{
+	x[k] = pos_in.x;
+	y[k] = pos_in.y;
+	ox[k] = oldpos_in.x;
+	oy[k] = oldpos_in.y;
+}
+
+void BodySet::Kill(const int &k)
+{
+	alive[k] = 0;
+}
+
+void BodySet::Revive(const int &k)
+{
+	alive[k] = -1;
+}
+
+//moves every body (and where it was) by dx,dy, so their velocities are kept
+void BodySet::Translate(const double &dx, const double &dy)
+{
+	int n = Count();
+	for( int k = 0; k < n; k++ )
+	{
+		x[k] += dx;
+		y[k] += dy;
+		ox[k] += dx;
+		oy[k] += dy;
+	}
+}
+
+//copies body k into the scratch body b, so the collision code can work on it
+void BodySet::Load(const int &k, Body &b) const
+{
+	b.id = k;
+	b.pos.x = x[k];
+	b.pos.y = y[k];
+	b.oldpos.x = ox[k];
+	b.oldpos.y = oy[k];
+	b.r = r[k];
+	b.dead = (alive[k] == 0);
+}
+
+//writes the scratch body b back into slot k
+void BodySet::Store(const int &k, const Body &b)
+{
+	x[k] = b.pos.x;
+	y[k] = b.pos.y;
+	ox[k] = b.oldpos.x;
+	oy[k] = b.oldpos.y;
+	alive[k] = b.dead ? 0 : -1;
+}
+
+//the same verlet step as Body::IntegrateVerlet(), for every body at once.
+//
+//4 bodies at a time, as a Vector2x4 (see vector2x.h); DRAG and GRAV are
+//broadcast to every lane, and the arithmetic is done in the same order as the
+//scalar version so the results are identical. dead bodies are masked out, so
+//they stay where they died.
+void BodySet::IntegrateVerlet()
+{
+	int n = Count();
+	int k = 0;
+	if( n == 0 )
+		return;
+
+	double *px = &x[0];
+	double *py = &y[0];
+	double *pox = &ox[0];
+	double *poy = &oy[0];
+	const int64_t *live = &alive[0];
+
+	Double4 d(DRAG);
+	Double4 g(GRAV);
+
+	for( ; k + 4 <= n; k += 4 )
+	{
+		Double4 m = Double4::LoadMask(live + k);
+		Vector2x4 c = Vector2x4::Load(px + k, py + k);
+		Vector2x4 l = Vector2x4::Load(pox + k, poy + k);
+
+		Vector2x4 step = (c*d) - (l*d);
+		step.y += g;
+
+		Select(m, c + step, c).Store(px + k, py + k);
+		Select(m, c, l).Store(pox + k, poy + k);
+	}
+
+	//leftovers
+	for( ; k < n; k++ )
+	{
+		if( live[k] == 0 )
+			continue;
+
+		double cx = px[k];
+		double cy = py[k];
+		double lx = pox[k];
+		double ly = poy[k];
+
+		pox[k] = cx;
+		poy[k] = cy;
+		px[k] += (DRAG*cx) - (DRAG*lx);
+		py[k] += (DRAG*cy) - (DRAG*ly) + GRAV;
+	}
+}
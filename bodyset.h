@@ -0,0 +1,57 @@
+//* bodyset.h *//
+
+#ifndef BODYSET_H
+#define BODYSET_H
+
+#include <vector>
+#include <stdint.h>
+
+#include "vector2.h"
+
+template<class T> class BodyT;
+typedef BodyT< double > Body;
+
+//all of the circles in a World, stored structure-of-arrays: body k is at
+//(x[k],y[k]), was at (ox[k],oy[k]) last tick and has radius r[k].
+//
+//keeping each field contiguous lets IntegrateVerlet() move 2 (SSE2) or 4 (AVX2)
+//bodies per instruction, which is what makes 100k+ balls per frame possible.
+//the collision code still works on one Body at a time; Load() copies body k
+//into a scratch Body and Store() copies it back.
+//
+//it's double only: there's no float BodySet (and so no float World) to put 8
+//bodies in an AVX2 register instead of 4; see BodyT.
+class BodySet
+{
+
+public:
+
+	std::vector< double > x;
+	std::vector< double > y;
+	std::vector< double > ox;
+	std::vector< double > oy;
+	std::vector< int > r;
+	std::vector< int64_t > alive;//all bits set while alive, 0 once dead; a lane mask for IntegrateVerlet()
+
+	BodySet() { }
+	~BodySet() { }
+
+	inline int Count() const { return (int)x.size(); }
+	inline int IsDead(const int &k) const { return alive[k] == 0; }
+
+	int Add(Vector2 pos_in, const int &r_in);
+	void Clear();
+
+	void Place(const int &k, const Vector2 &pos_in, const Vector2 &oldpos_in);
+	void Kill(const int &k);
+	void Revive(const int &k);
+	void Translate(const double &dx, const double &dy);
+
+	void Load(const int &k, Body &b) const;
+	void Store(const int &k, const Body &b);
+
+	void IntegrateVerlet();
+
+};
+
+#endif //BODYSET_H
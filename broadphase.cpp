@@ -0,0 +1,363 @@
+//* broadphase.cpp *//
+
+#include <cmath>
+#include <vector>
+
+#include "fixed.h"
+#include "body.h"
+#include "bodyset.h"
+#include "collisionbuffer.h"
+#include "jobsystem.h"
+#include "broadphase.h"
+
+using namespace std;
+
+//half of the bands of one step (every other one, from first), a band per job.
+//every job records its contacts in a buffer of its own; put in the World's one
+//job after another, they're in the same order CollideGrid() records them in
+//without a JobSystem.
+class BandJobs : public JobList
+{
+
+public:
+
+	Broadphase *bp;
+	int first;//job n is band first + 2*n
+	vector< CollisionBuffer > collisions;//one per job,
+	vector< int > contacts;//and how many it found
+
+	void Do(const int &job)
+	{
+		CollisionBuffer &buf = collisions[job];
+		buf.Clear();
+		contacts[job] = 0;
+
+		int band = first + 2*job;
+		if( bp->fixed )
+			bp->CollideBand< Fixed >(band, &buf, contacts[job]);
+		else if( bp->single )
+			bp->CollideBand< float >(band, &buf, contacts[job]);
+		else
+			bp->CollideBand< double >(band, &buf, contacts[job]);
+	}
+};
+
+Broadphase::Broadphase()
+{
+	cellw = cellh = 1;
+	gcols = grows = 0;
+	fixed = 0;
+	single = 0;
+	jobs = NULL;
+	bandjobs = NULL;
+}
+
+Broadphase::~Broadphase()
+{
+	delete bandjobs;
+}
+
+//sorts the live bodies into a grid covering (0,0)-(width,height); bodies outside
+//of it are put in the border cells. cells are at least minsize wide/high.
+void Broadphase::Bin(const BodySet &bodies, const double &width, const double &height, const double &minsize)
+{
+	int n = bodies.Count();
+
+	double maxr = 0;
+	for( int k = 0; k < n; k++ )
+	{
+		if( maxr < bodies.r[k] )
+			maxr = bodies.r[k];
+	}
+
+	cellw = cellh = (minsize < 2*maxr) ? 2*maxr : minsize;
+	if( cellw <= 0 )
+		cellw = cellh = 1;
+
+	//(the sizes are whole pixels; in fixed, the quotients are worked out in
+	//integers, so no float setting can put a body in a different cell)
+	int cw = (int)cellw;
+	int ch = (int)cellh;
+	if( fixed )
+	{
+		gcols = (int)width / cw + 1;
+		grows = (int)height / ch + 1;
+	}
+	else
+	{
+		gcols = (int)(width / cellw) + 1;
+		grows = (int)(height / cellh) + 1;
+	}
+
+	start.assign( gcols*grows + 1, 0 );
+	cell.resize( n );
+
+	//count..
+	for( int k = 0; k < n; k++ )
+	{
+		if( bodies.IsDead(k) )
+		{
+			cell[k] = -1;
+			continue;
+		}
+
+		int i, j;
+		if( fixed )
+		{
+			//as BodyFixed::Cell()
+			i = (int)( Fixed(bodies.x[k]).raw / (cw * Fixed::ONE) );
+			j = (int)( Fixed(bodies.y[k]).raw / (ch * Fixed::ONE) );
+		}
+		else
+		{
+			i = (int)(bodies.x[k] / cellw);
+			j = (int)(bodies.y[k] / cellh);
+		}
+		if( i < 0 ) i = 0; else if( gcols <= i ) i = gcols-1;
+		if( j < 0 ) j = 0; else if( grows <= j ) j = grows-1;
+
+		cell[k] = j*gcols + i;
+		start[ cell[k] + 1 ]++;
+	}
+
+	//..prefix sum..
+	for( int c = 0; c < gcols*grows; c++ )
+	{
+		start[c+1] += start[c];
+	}
+
+	//..and scatter into sorted order; start[c] is used as the insertion point and
+	//ends up at the start of cell c+1, so it's shifted back afterwards
+	int live = start[ gcols*grows ];
+	order.resize( live );
+	x.resize( live );
+	y.resize( live );
+	ox.resize( live );
+	oy.resize( live );
+	r.resize( live );
+
+	for( int k = 0; k < n; k++ )
+	{
+		if( cell[k] < 0 )
+			continue;
+
+		int s = start[ cell[k] ]++;
+		order[s] = k;
+		x[s] = bodies.x[k];
+		y[s] = bodies.y[k];
+		ox[s] = bodies.ox[k];
+		oy[s] = bodies.oy[k];
+		r[s] = bodies.r[k];
+	}
+
+	for( int c = gcols*grows; 0 < c; c-- )
+	{
+		start[c] = start[c-1];
+	}
+	start[0] = 0;
+}
+
+//finds and resolves every touching pair of live bodies, and records them in
+//collisions (which may be NULL); returns the number of contacts
+int Broadphase::Collide(BodySet &bodies, const double &width, const double &height, const double &minsize, CollisionBuffer *collisions)
+{
+	if( bodies.Count() < 2 )
+		return 0;
+
+	Bin(bodies, width, height, minsize);
+
+	int contacts = 0;
+	if( fixed )
+		CollideGrid< Fixed >(collisions, contacts);
+	else if( single )
+		CollideGrid< float >(collisions, contacts);
+	else
+		CollideGrid< double >(collisions, contacts);
+
+	//copy the results back
+	int live = (int)order.size();
+	for( int s = 0; s < live; s++ )
+	{
+		int k = order[s];
+		bodies.x[k] = x[s];
+		bodies.y[k] = y[s];
+		bodies.ox[k] = ox[s];
+		bodies.oy[k] = oy[s];
+	}
+
+	return contacts;
+}
+
+//the pairs of the binned bodies, band by band, with the math in T: the even
+//bands, then the odd ones (see above). with a JobSystem, each half is run as a
+//batch of jobs, and their contacts are put in collisions in band order.
+template<class T>
+void Broadphase::CollideGrid(CollisionBuffer *collisions, int &contacts)
+{
+	int bands = (grows + BROADPHASE_BAND - 1) / BROADPHASE_BAND;
+	for( int first = 0; first < 2; first++ )
+	{
+		int count = (bands - first + 1) / 2;
+		if( jobs == NULL || jobs->Threads() < 2 || count < 2 )
+		{
+			for( int band = first; band < bands; band += 2 )
+				CollideBand<T>(band, collisions, contacts);
+			continue;
+		}
+
+		if( bandjobs == NULL )
+		{
+			bandjobs = new BandJobs();
+			bandjobs->bp = this;
+		}
+		BandJobs &bj = *bandjobs;
+		bj.first = first;
+		if( (int)bj.collisions.size() < count )
+		{
+			bj.collisions.resize(count);
+			bj.contacts.resize(count);
+		}
+
+		jobs->Run(&bj, count);
+
+		for( int job = 0; job < count; job++ )
+		{
+			contacts += bj.contacts[job];
+			const CollisionBuffer &buf = bj.collisions[job];
+			for( int q = 0; collisions != NULL && q < buf.Count(); q++ )
+				collisions->Add( buf[q] );
+		}
+	}
+}
+
+//the pairs of the cells in one band of rows; a cell is checked against itself
+//and its forward neighbors, which may be in the first row of the next band
+template<class T>
+void Broadphase::CollideBand(const int &band, CollisionBuffer *collisions, int &contacts)
+{
+	int jend = (band+1)*BROADPHASE_BAND;
+	if( grows < jend )
+		jend = grows;
+
+	for( int j = band*BROADPHASE_BAND; j < jend; j++ )
+	{
+		for( int i = 0; i < gcols; i++ )
+		{
+			int c = j*gcols + i;
+			if( start[c] == start[c+1] )
+				continue;
+
+			CollideCells<T>(c, c, collisions, contacts);
+			if( i < gcols-1 )
+				CollideCells<T>(c, c+1, collisions, contacts);
+			if( j < grows-1 )
+			{
+				if( 0 < i )
+					CollideCells<T>(c, c+gcols-1, collisions, contacts);
+				CollideCells<T>(c, c+gcols, collisions, contacts);
+				if( i < gcols-1 )
+					CollideCells<T>(c, c+gcols+1, collisions, contacts);
+			}
+		}
+	}
+}
+
+//tests every body in cell c against every body in cell n (each pair once when c == n)
+template<class T>
+void Broadphase::CollideCells(const int &c, const int &n, CollisionBuffer *collisions, int &contacts)
+{
+	int aend = start[c+1];
+	int bend = start[n+1];
+
+	for( int a = start[c]; a < aend; a++ )
+	{
+		int b = (c == n) ? a+1 : start[n];
+		for( ; b < bend; b++ )
+		{
+			T dx = (T)x[a] - (T)x[b];
+			T dy = (T)y[a] - (T)y[b];
+			T rr = (T)r[a] + (T)r[b];
+			if( rr <= abs(dx) || rr <= abs(dy) )
+				continue;//(bodies off the grid share its border cells, and can be far apart; a Fixed would overflow squaring that)
+			T d2 = dx*dx + dy*dy;
+
+			if( rr*rr <= d2 )
+				continue;
+
+			//normal points from b towards a
+			T len = sqrt(d2);
+			if( (T)0 < len )
+			{
+				dx /= len;
+				dy /= len;
+			}
+			else
+			{
+				dx = 0;//exactly on top of each other; push apart vertically
+				dy = -1;
+			}
+
+			T pen = rr - len;
+			T impulse = ReportCollisionVsBody<T>(a, b, dx*pen, dy*pen, dx, dy);
+			contacts++;
+
+			if( collisions != NULL )
+				collisions->Add( order[a], order[b], -1, -1, (double)dx, (double)dy, (double)impulse );
+		}
+	}
+}
+
+//(px,py) is the projection vector that separates a from b, (dx,dy) the contact normal pointing towards a.
+//
+//this is ReportCollisionVsWorld() for two bodies of equal mass: the bounce and
+//friction impulses are worked out from the relative velocity, and both the
+//projection and the impulses are split evenly between the two bodies. returns
+//how hard they hit: the relative speed they lost along the normal.
+template<class T>
+T Broadphase::ReportCollisionVsBody(const int &a, const int &b, const T &px, const T &py, const T &dx, const T &dy)
+{
+	//calc relative velocity
+	T vx = ((T)x[a] - (T)ox[a]) - ((T)x[b] - (T)ox[b]);
+	T vy = ((T)y[a] - (T)oy[a]) - ((T)y[b] - (T)oy[b]);
+
+	//find component of velocity parallel to collision normal
+	T dp = (vx*dx + vy*dy);
+	T nx = dp*dx;//project velocity onto collision normal
+	T ny = dp*dy;//nx,ny is normal velocity
+
+	T tx = vx-nx;//tx,ty is tangent velocity
+	T ty = vy-ny;
+
+	//only apply response forces if the bodies are moving towards each other
+	T bx,by,fx,fy;
+	if(dp < (T)0)
+	{
+		fx = tx*(T)FRICTION;
+		fy = ty*(T)FRICTION;
+
+		bx = nx*(T)(1+BOUNCE);
+		by = ny*(T)(1+BOUNCE);
+	}
+	else
+	{
+		bx = by = fx = fy = (T)0;
+	}
+
+	T half = (T)0.5;
+	T hx = half*px;
+	T hy = half*py;
+	T ix = half*(bx + fx);
+	T iy = half*(by + fy);
+
+	x[a] = (double)( (T)x[a] + hx );//project bodies out of each other
+	y[a] = (double)( (T)y[a] + hy );
+	ox[a] = (double)( (T)ox[a] + (hx + ix) );//apply bounce+friction impulses which alter velocity
+	oy[a] = (double)( (T)oy[a] + (hy + iy) );
+
+	x[b] = (double)( (T)x[b] - hx );
+	y[b] = (double)( (T)y[b] - hy );
+	ox[b] = (double)( (T)ox[b] - (hx + ix) );
+	oy[b] = (double)( (T)oy[b] - (hy + iy) );
+
+	return (dp < (T)0) ? -dp*(T)(1+BOUNCE) : (T)0;
+}
@@ -0,0 +1,87 @@
+//* broadphase.h *//
+
+#ifndef BROADPHASE_H
+#define BROADPHASE_H
+
+#include <vector>
+
+class BodySet;
+class CollisionBuffer;
+class JobSystem;
+class BandJobs;
+
+const int BROADPHASE_BAND = 4;//rows of cells in a band (see Broadphase::CollideGrid())
+
+//circle-vs-circle collisions between the bodies of a BodySet.
+//
+//every step the live bodies are binned into a uniform grid by counting sort:
+//cells are at least as big as a tile, and at least as big as the largest ball,
+//so a body can only touch bodies in its own cell or the 8 around it. each cell
+//is then checked against itself and its 4 "forward" neighbors (right, and the 3
+//below) so every pair is seen once.
+//
+//the bodies are copied into cell order first (x, y, .. below) and resolved
+//there, so the pairs are visited walking through memory more or less in order;
+//the results are copied back into the BodySet at the end.
+//
+//the cells are resolved in bands of BROADPHASE_BAND rows: every other band
+//first (0, 2, 4..), then the ones in between. a band only reaches one row into
+//the band below, so the bands of each half never touch the same bodies, and
+//with a JobSystem they're resolved in parallel. the order is the same with or
+//without one, so the bodies end up in the same places however many threads
+//there are.
+//
+//every contact is recorded in a CollisionBuffer, for the World to pass on once
+//the step is done (see World::collisions).
+//
+//with fixed set, the bodies are binned and the pairs resolved in Fixed (see
+//fixed.h), as a BodyFixed would, so a World with fixed set plays out the same
+//everywhere however many balls it has. they're still kept in double in
+//between, which a Fixed goes through unchanged. with single set, the pairs are
+//resolved in float instead, for a World with single set.
+class Broadphase
+{
+
+public:
+
+	double cellw;//cell dimensions
+	double cellh;
+	int gcols;//grid dimensions in cells
+	int grows;
+
+	int fixed;//if set, everything is worked out in Fixed; the World sets it along with its own
+	int single;//if set (and fixed isn't), the pairs are worked out in float; likewise
+
+	JobSystem *jobs;//if set, the bands are resolved on its threads; may be NULL. the World sets it to its own
+
+	std::vector< int > start;//bodies in cell c are order[ start[c] .. start[c+1]-1 ]
+	std::vector< int > order;//body index in the BodySet, per sorted slot
+	std::vector< int > cell;//cell of each body in the BodySet, or -1 when dead
+
+	std::vector< double > x;//the bodies, in sorted order
+	std::vector< double > y;
+	std::vector< double > ox;
+	std::vector< double > oy;
+	std::vector< double > r;
+
+	Broadphase();
+	~Broadphase();
+
+	void Bin(const BodySet &bodies, const double &width, const double &height, const double &minsize);
+	int Collide(BodySet &bodies, const double &width, const double &height, const double &minsize, CollisionBuffer *collisions);
+
+	template<class T> void CollideGrid(CollisionBuffer *collisions, int &contacts);
+	template<class T> void CollideBand(const int &band, CollisionBuffer *collisions, int &contacts);
+	template<class T> void CollideCells(const int &c, const int &n, CollisionBuffer *collisions, int &contacts);
+	template<class T> T ReportCollisionVsBody(const int &a, const int &b, const T &px, const T &py, const T &dx, const T &dy);
+
+private:
+
+	BandJobs *bandjobs;//what CollideGrid() hands to jobs; made the first time it's needed
+
+	Broadphase(const Broadphase&);
+	Broadphase& operator=(const Broadphase&);
+
+};
+
+#endif //BROADPHASE_H
@@ -0,0 +1,477 @@
+//* chunkstore.cpp *//
+
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include <string>
+
+#include "tilegrid.h"
+#include "bodyset.h"
+#include "chunkstore.h"
+
+using namespace std;
+
+static unsigned int GetU32(const unsigned char *p)
+{
+	return p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned int)p[3] << 24);
+}
+
+static void PutU32(unsigned char *p, const unsigned int &v)
+{
+	p[0] = v & 0xFF;
+	p[1] = (v >> 8) & 0xFF;
+	p[2] = (v >> 16) & 0xFF;
+	p[3] = (v >> 24) & 0xFF;
+}
+
+//worlds can be bigger than a long can seek through on some platforms
+static int Seek(FILE *f, const long long &pos)
+{
+#if defined(_WIN32)
+	return _fseeki64(f, pos, SEEK_SET);
+#else
+	return fseeko(f, (off_t)pos, SEEK_SET);
+#endif
+}
+
+static long long FileSize(FILE *f)
+{
+#if defined(_WIN32)
+	if( _fseeki64(f, 0, SEEK_END) != 0 )
+		return -1;
+	return _ftelli64(f);
+#else
+	if( fseeko(f, 0, SEEK_END) != 0 )
+		return -1;
+	return ftello(f);
+#endif
+}
+
+static inline long long ChunkOffset(const int &c)
+{
+	return WORLD_HEADER + (long long)c * CHUNK_BYTES;
+}
+
+ChunkStore::ChunkStore()
+{
+	file = NULL;
+	chunkcols = chunkrows = 0;
+	xw = yw = 0;
+	radius = span = 0;
+	oci = ocj = 0;
+	window = NULL;
+	clock = 0;
+	ahead = aheadci = aheadcj = -1;
+	hits = misses = reads = writes = slides = 0;
+}
+
+ChunkStore::~ChunkStore()
+{
+	Close();
+}
+
+//writes a new world of chunkcols x chunkrows chunks, asking source for the ID of
+//every cell (source may be NULL, for an empty world). the outermost ring of cells
+//is always solid and unbreakable, so nothing can leave the world.
+//
+//each chunk is worked out in a TileGrid one cell larger than the chunk on every
+//side, holding its neighbors' cells too, so its edges come out the same as if
+//the whole world had been built at once. the colors come from seed and the
+//chunk's position, not from the order the chunks are made in.
+bool ChunkStore::Create(const string &filename, const int &chunkcols_in, const int &chunkrows_in, const int &xw_in, const int &yw_in,
+						TileSource source, void *ctx, const unsigned int &seed)
+{
+	FILE *f = fopen(filename.c_str(), "wb");
+	if( f == NULL )
+		return false;
+
+	unsigned char header[WORLD_HEADER];
+	memset(header, 0, sizeof(header));
+	memcpy(header, "BWLD", 4);
+	PutU32(header + 4, WORLD_VERSION);
+	PutU32(header + 8, chunkcols_in);
+	PutU32(header + 12, chunkrows_in);
+	PutU32(header + 16, xw_in);
+	PutU32(header + 20, yw_in);
+	PutU32(header + 24, CHUNK);
+
+	bool ok = ( fwrite(header, 1, WORLD_HEADER, f) == (size_t)WORLD_HEADER );
+
+	int worldcols = chunkcols_in*CHUNK;
+	int worldrows = chunkrows_in*CHUNK;
+
+	TileGrid g(CHUNK, CHUNK, xw_in, yw_in);
+	vector< unsigned char > cells(CHUNK_BYTES);
+
+	for( int cj = 0; cj < chunkrows_in && ok; cj++ )
+	{
+		for( int ci = 0; ci < chunkcols_in && ok; ci++ )
+		{
+			g.Alloc();
+			g.rng.Seed( seed ^ ((cj*chunkcols_in + ci + 1) * 2654435761u) );
+
+			for( int j = 0; j < g.fullrows; j++ )
+			{
+				for( int i = 0; i < g.fullcols; i++ )
+				{
+					int gi = ci*CHUNK + i - 1;
+					int gj = cj*CHUNK + j - 1;
+					int k = g.Index(i, j);
+					int ID = TID_EMPTY;
+
+					if( gi < 0 || gj < 0 || worldcols <= gi || worldrows <= gj )
+						ID = TID_EMPTY;//off the world
+					else if( gi == 0 || gj == 0 || gi == worldcols-1 || gj == worldrows-1 )
+					{
+						ID = TID_FULL;
+						g.mat[k] |= MAT_UNBREAKABLE;
+					}
+					else if( source != NULL )
+						ID = source(gi, gj, ctx);
+
+					if( ID != TID_EMPTY )
+						g.RollColor(k);
+					g.id[k] = ID;
+				}
+			}
+
+			g.BuildTypes();
+			g.BuildEdges();
+
+			//keep the chunk, without the ring of neighbors around it
+			const unsigned char *planes[LEVEL_PLANES] = { g.id, g.ctype, g.edges, g.signs, g.hp, g.mat };
+			for( int p = 0; p < LEVEL_PLANES; p++ )
+			{
+				for( int j = 0; j < CHUNK; j++ )
+				{
+					memcpy(&cells[p*CHUNK_CELLS + j*CHUNK], planes[p] + g.Index(1, j+1), CHUNK);
+				}
+			}
+
+			ok = ( fwrite(&cells[0], 1, CHUNK_BYTES, f) == (size_t)CHUNK_BYTES );
+		}
+	}
+
+	return (fclose(f) == 0) && ok;
+}
+
+//opens a world made by Create(). the window will hold (2*radius_in+1)^2 chunks;
+//the cache gets capacity chunk slots, but never fewer than the window plus a
+//ring of read-ahead around it, or read-ahead would push the window's own
+//chunks out.
+bool ChunkStore::Open(const string &filename, const int &radius_in, const int &capacity)
+{
+	Close();
+
+	file = fopen(filename.c_str(), "r+b");
+	if( file == NULL )
+		return false;
+
+	unsigned char header[WORLD_HEADER];
+	if( fread(header, 1, WORLD_HEADER, file) != (size_t)WORLD_HEADER || memcmp(header, "BWLD", 4) != 0 ||
+		(int)GetU32(header + 4) != WORLD_VERSION || (int)GetU32(header + 24) != CHUNK )
+	{
+		//"ChunkStore::Open(): not a world, or a version we can't read"
+		Close();
+		return false;
+	}
+
+	chunkcols = GetU32(header + 8);
+	chunkrows = GetU32(header + 12);
+	xw = GetU32(header + 16);
+	yw = GetU32(header + 20);
+
+	radius = radius_in;
+	span = 2*radius + 1;
+
+	if( chunkcols < span || chunkrows < span || FileSize(file) < ChunkOffset(chunkcols*chunkrows) )
+	{
+		//"ChunkStore::Open(): the world is cut short, or smaller than the window"
+		Close();
+		return false;
+	}
+
+	int slots = (span+2)*(span+2);
+	TileChunk freeslot;
+	freeslot.c = -1;
+	freeslot.dirty = 0;
+	freeslot.used = 0;
+	cache.assign( (capacity < slots) ? slots : capacity, freeslot );
+
+	clock = 0;
+	ahead = aheadci = aheadcj = -1;
+	hits = misses = reads = writes = slides = 0;
+	return true;
+}
+
+//writes back everything that changed and lets go of the file
+void ChunkStore::Close()
+{
+	if( file != NULL )
+	{
+		Flush();
+		fclose(file);
+	}
+	file = NULL;
+	window = NULL;
+	cache.clear();
+}
+
+//makes window_in a window onto the world, as near as it can get to being
+//centered on chunk (ci, cj); its old size and tiles are thrown away
+void ChunkStore::Attach(TileGrid *window_in, const int &ci, const int &cj)
+{
+	window = window_in;
+	window->SetSize(span*CHUNK - 2, span*CHUNK - 2, xw, yw);//the grid's border ring is part of the window too
+	window->Alloc();
+	window->killY = HUGE_VAL;//the world is closed on all sides
+
+	int nci = ci - radius;
+	int ncj = cj - radius;
+	if( nci < 0 ) nci = 0;
+	if( ncj < 0 ) ncj = 0;
+	if( chunkcols-span < nci ) nci = chunkcols-span;
+	if( chunkrows-span < ncj ) ncj = chunkrows-span;
+
+	oci = ocj = -1;//nothing to put back yet
+	Slide(nci, ncj);
+}
+
+//writes the window back into the cache and forgets it; the grid keeps its tiles
+void ChunkStore::Detach()
+{
+	Flush();
+	window = NULL;
+}
+
+//writes the window back into the cache, and every dirty chunk to disk
+void ChunkStore::Flush()
+{
+	if( file == NULL )
+		return;
+
+	if( window != NULL && 0 <= oci )
+	{
+		for( int wj = 0; wj < span; wj++ )
+		{
+			for( int wi = 0; wi < span; wi++ )
+			{
+				PutWindow(wi, wj, *Fetch(ChunkIndex(oci+wi, ocj+wj), 0));
+			}
+		}
+	}
+
+	for( int s = 0; s < (int)cache.size(); s++ )
+	{
+		if( cache[s].c != -1 && cache[s].dirty )
+			WriteChunk(cache[s]);
+	}
+	fflush(file);
+}
+
+//keeps the window centered on the live bodies; call it once per step, before
+//they move. when the window slides, the bodies, and the pad, are moved the
+//other way by as much, so they stay where they were in the world. returns
+//nonzero if the window slid.
+int ChunkStore::Follow(BodySet &bodies, int &padx, int &pady)
+{
+	double cx = 0, cy = 0;
+	double vx = 0, vy = 0;
+	int live = 0;
+
+	int n = bodies.Count();
+	for( int k = 0; k < n; k++ )
+	{
+		if( bodies.IsDead(k) )
+			continue;
+		cx += bodies.x[k];
+		cy += bodies.y[k];
+		vx += bodies.x[k] - bodies.ox[k];
+		vy += bodies.y[k] - bodies.oy[k];
+		live++;
+	}
+	if( live == 0 )
+		return 0;
+
+	double cw = CHUNK*window->tw;//size of a chunk, in pixels
+	double ch = CHUNK*window->th;
+
+	int nci = oci + (int)floor( (cx/live) / cw ) - radius;
+	int ncj = ocj + (int)floor( (cy/live) / ch ) - radius;
+	if( nci < 0 ) nci = 0;
+	if( ncj < 0 ) ncj = 0;
+	if( chunkcols-span < nci ) nci = chunkcols-span;
+	if( chunkrows-span < ncj ) ncj = chunkrows-span;
+
+	int slid = 0;
+	if( nci != oci || ncj != ocj )
+	{
+		double dx = (oci - nci)*cw;
+		double dy = (ocj - ncj)*ch;
+
+		Slide(nci, ncj);
+		bodies.Translate(dx, dy);
+		padx += (int)dx;
+		pady += (int)dy;
+		slid = 1;
+	}
+
+	ReadAhead( (0 < vx) - (vx < 0), (0 < vy) - (vy < 0) );
+	return slid;
+}
+
+//x,y (in the window) is too near the edge of the window for the collision code,
+//which looks at the cells all around the one a body is in
+bool ChunkStore::Outside(const double &x, const double &y) const
+{
+	return x < window->tw || y < window->th || (window->fullcols-1)*window->tw <= x || (window->fullrows-1)*window->th <= y;
+}
+
+//moves the window's top-left corner to chunk (oci_in, ocj_in)
+void ChunkStore::Slide(const int &oci_in, const int &ocj_in)
+{
+	if( 0 <= oci )
+	{
+		for( int wj = 0; wj < span; wj++ )
+		{
+			for( int wi = 0; wi < span; wi++ )
+			{
+				PutWindow(wi, wj, *Fetch(ChunkIndex(oci+wi, ocj+wj), 0));
+			}
+		}
+	}
+
+	oci = oci_in;
+	ocj = ocj_in;
+
+	for( int wj = 0; wj < span; wj++ )
+	{
+		for( int wi = 0; wi < span; wi++ )
+		{
+			GetWindow(wi, wj, *Fetch(ChunkIndex(oci+wi, ocj+wj), 1));
+		}
+	}
+
+	window->BuildEdges();//stitches the seams
+	window->MapChanged();
+	slides++;
+}
+
+//brings the chunks just past the window's side (dx) and/or top/bottom (dy) into
+//the cache, corners included, ahead of the window sliding that way
+void ChunkStore::ReadAhead(const int &dx, const int &dy)
+{
+	int dir = (dx+1) | ((dy+1) << 2);
+	if( dir == ahead && oci == aheadci && ocj == aheadcj )
+		return;
+	ahead = dir;
+	aheadci = oci;
+	aheadcj = ocj;
+
+	int ci0 = oci + ((dx < 0) ? -1 : 0);
+	int ci1 = oci + span-1 + ((0 < dx) ? 1 : 0);
+	int cj0 = ocj + ((dy < 0) ? -1 : 0);
+	int cj1 = ocj + span-1 + ((0 < dy) ? 1 : 0);
+	if( ci0 < 0 ) ci0 = 0;
+	if( cj0 < 0 ) cj0 = 0;
+	if( chunkcols-1 < ci1 ) ci1 = chunkcols-1;
+	if( chunkrows-1 < cj1 ) cj1 = chunkrows-1;
+
+	for( int cj = cj0; cj <= cj1; cj++ )
+	{
+		for( int ci = ci0; ci <= ci1; ci++ )
+		{
+			int inside = (oci <= ci && ci < oci+span) && (ocj <= cj && cj < ocj+span);
+			if( !inside )
+				Fetch(ChunkIndex(ci, cj), 1);
+		}
+	}
+}
+
+//returns the cache slot holding chunk c, recycling the least recently used one
+//if it isn't there. a recycled slot is read from disk only if load is set;
+//otherwise the caller is about to overwrite it, and it's marked dirty.
+TileChunk* ChunkStore::Fetch(const int &c, const int &load)
+{
+	int lru = 0;
+	for( int s = 0; s < (int)cache.size(); s++ )
+	{
+		if( cache[s].c == c )
+		{
+			hits++;
+			cache[s].used = ++clock;
+			return &cache[s];
+		}
+		if( cache[s].used < cache[lru].used )
+			lru = s;
+	}
+
+	misses++;
+	TileChunk &chunk = cache[lru];
+	Evict(chunk);
+	chunk.c = c;
+	chunk.used = ++clock;
+	if( load )
+		ReadChunk(chunk);
+	else
+		chunk.dirty = 1;
+	return &chunk;
+}
+
+void ChunkStore::ReadChunk(TileChunk &chunk)
+{
+	Seek(file, ChunkOffset(chunk.c));
+	if( fread(chunk.cells, 1, CHUNK_BYTES, file) != (size_t)CHUNK_BYTES )
+		memset(chunk.cells, 0, CHUNK_BYTES);//can't happen to a file that passed Open()
+	chunk.dirty = 0;
+	reads++;
+}
+
+void ChunkStore::WriteChunk(TileChunk &chunk)
+{
+	Seek(file, ChunkOffset(chunk.c));
+	fwrite(chunk.cells, 1, CHUNK_BYTES, file);
+	chunk.dirty = 0;
+	writes++;
+}
+
+void ChunkStore::Evict(TileChunk &chunk)
+{
+	if( chunk.c != -1 && chunk.dirty )
+		WriteChunk(chunk);
+	chunk.c = -1;
+	chunk.used = 0;
+}
+
+//copies the window's chunk (wi, wj) into chunk, marking it dirty if anything changed
+void ChunkStore::PutWindow(const int &wi, const int &wj, TileChunk &chunk)
+{
+	unsigned char *planes[LEVEL_PLANES] = { window->id, window->ctype, window->edges, window->signs, window->hp, window->mat };
+	for( int p = 0; p < LEVEL_PLANES; p++ )
+	{
+		for( int j = 0; j < CHUNK; j++ )
+		{
+			const unsigned char *src = planes[p] + window->Index(wi*CHUNK, wj*CHUNK + j);
+			unsigned char *dst = chunk.cells + p*CHUNK_CELLS + j*CHUNK;
+			if( memcmp(dst, src, CHUNK) != 0 )
+			{
+				memcpy(dst, src, CHUNK);
+				chunk.dirty = 1;
+			}
+		}
+	}
+}
+
+//copies chunk into the window's chunk (wi, wj)
+void ChunkStore::GetWindow(const int &wi, const int &wj, const TileChunk &chunk)
+{
+	unsigned char *planes[LEVEL_PLANES] = { window->id, window->ctype, window->edges, window->signs, window->hp, window->mat };
+	for( int p = 0; p < LEVEL_PLANES; p++ )
+	{
+		for( int j = 0; j < CHUNK; j++ )
+		{
+			memcpy(planes[p] + window->Index(wi*CHUNK, wj*CHUNK + j), chunk.cells + p*CHUNK_CELLS + j*CHUNK, CHUNK);
+		}
+	}
+}
@@ -0,0 +1,131 @@
+//* chunkstore.h *//
+
+#ifndef CHUNKSTORE_H
+#define CHUNKSTORE_H
+
+#include <cstdio>
+#include <vector>
+#include <string>
+
+#include "levelfile.h"
+
+class TileGrid;
+class BodySet;
+
+const int CHUNK = 32;//tiles per side of a chunk
+const int CHUNK_CELLS = CHUNK*CHUNK;
+const int CHUNK_BYTES = LEVEL_PLANES*CHUNK_CELLS;
+
+const int WORLD_VERSION = 1;
+const int WORLD_HEADER = 32;//bytes
+
+//gives the tile ID at global cell (gi, gj) of a world being made by ChunkStore::Create()
+typedef int (*TileSource)(const int &gi, const int &gj, void *ctx);
+
+//one chunk of a streamed world, as it sits in the cache: the same 6 planes as a
+//TileGrid (id, ctype, edges, signs, hp, mat), each CHUNK x CHUNK, row-major
+struct TileChunk
+{
+	int c;//index of the chunk in the world (cj*chunkcols + ci), or -1 if the slot is free
+	int dirty;//differs from what's on disk
+	unsigned int used;//when it was last touched, for the LRU
+	unsigned char cells[CHUNK_BYTES];
+};
+
+//a tile world far larger than memory, kept on disk as fixed-size chunks.
+//
+//the simulation never sees the chunks: it keeps colliding against an ordinary
+//TileGrid, the "window", which holds span x span chunks (span = 2*radius+1)
+//around the live bodies. when the bodies cross into another chunk, the window
+//slides by whole chunks: its chunks go back to the cache, the new ones come in
+//from the cache (or from disk, on a miss), and the bodies and the pad are moved
+//by the same amount, so the window's own coordinates stay small (a "floating
+//origin"). global = local + origin*CHUNK tiles. the window follows the middle of
+//the live bodies; a body that strays off the window dies (see World::Step()).
+//
+//the cache is a fixed number of chunk slots, recycled least-recently-used first;
+//a dirty chunk is written back to disk when its slot is recycled, or on Close().
+//the chunks next to the window on the side the bodies are moving towards are
+//read ahead, so sliding the window rarely waits on the disk. memory use is the
+//window plus the cache, whatever the size of the world.
+//
+//each chunk stores its edges, worked out across the chunk seams when the world
+//was made. when the window slides, it redoes its edges in one pass (see
+//TileGrid::BuildEdges()), which stitches the seams back together if a tile next
+//to one was broken while its neighbor chunk was paged out. edges on the window's
+//outer ring can be stale, but nothing gets close enough to collide with them
+//before the window has slid past them.
+//
+//file layout (numbers are u32, little-endian):
+//	header, WORLD_HEADER bytes; "BWLD", version, chunkcols, chunkrows, xw, yw,
+//	CHUNK, and a reserved word
+//	chunkcols*chunkrows chunks of CHUNK_BYTES each, row-major
+class ChunkStore
+{
+
+public:
+
+	FILE *file;
+
+	int chunkcols;//size of the world, in chunks
+	int chunkrows;
+	int xw;//tile halfwidths
+	int yw;
+
+	int radius;//chunks around the middle one, in the window
+	int span;//chunks per side of the window
+	int oci;//the window's top-left chunk
+	int ocj;
+
+	TileGrid *window;//NULL until Attach()
+
+	std::vector< TileChunk > cache;
+	unsigned int clock;
+
+	int ahead;//direction of the last read-ahead (-1/0/1 for x and y, packed), so it's only done once
+	int aheadci;
+	int aheadcj;
+
+	int hits;//stats, for the benchmarks
+	int misses;
+	int reads;
+	int writes;
+	int slides;
+
+	ChunkStore();
+	~ChunkStore();
+
+	static bool Create(const std::string &filename, const int &chunkcols_in, const int &chunkrows_in, const int &xw_in, const int &yw_in,
+					   TileSource source, void *ctx, const unsigned int &seed);
+
+	bool Open(const std::string &filename, const int &radius_in, const int &capacity);
+	void Close();
+
+	void Attach(TileGrid *window_in, const int &ci, const int &cj);
+	void Detach();
+	void Flush();
+	int Follow(BodySet &bodies, int &padx, int &pady);
+	bool Outside(const double &x, const double &y) const;
+
+	inline int ChunkIndex(const int &ci, const int &cj) const { return cj*chunkcols + ci; }
+	inline size_t Resident() const { return cache.size()*sizeof(TileChunk) + (size_t)span*span*CHUNK_BYTES; }//bytes
+
+private:
+
+	void Slide(const int &oci_in, const int &ocj_in);
+	void ReadAhead(const int &dx, const int &dy);
+
+	TileChunk* Fetch(const int &c, const int &load);
+	void ReadChunk(TileChunk &chunk);
+	void WriteChunk(TileChunk &chunk);
+	void Evict(TileChunk &chunk);
+
+	void PutWindow(const int &wi, const int &wj, TileChunk &chunk);
+	void GetWindow(const int &wi, const int &wj, const TileChunk &chunk);
+
+	ChunkStore(const ChunkStore&);//not copyable; it owns the file
+	ChunkStore& operator=(const ChunkStore&);
+
+};
+
+#endif //CHUNKSTORE_H
@@ -0,0 +1,230 @@
+//* clearability.cpp *//
+
+//finds out which launches clear each stage. NextStage() puts the ball at
+//(START_X, START_Y) plus an offset of (n-50)/250 on each axis, n in [0, 100), so
+//there are 100x100 ways a stage can start (times whatever the seed does to the
+//tiles). this plays a res x res sample of those starts, each with a few seeds,
+//headless and across every core (see BatchRunner), with the pad flown by the
+//autopilot, which always does the same thing in the same spot. for every stage
+//it prints:
+//
+//	a heatmap of outcomes over the start offsets, dx across and dy down: '#' if
+//	every seed cleared the board, 'x' if one died (the ball got under the
+//	y > killY line, see Body::CollideCirclevsTileMap()), 'X' if they all did,
+//	'.' if none of them cleared it or died, and otherwise how many tenths of
+//	them cleared it.
+//
+//	the stage's tiles, marking the ones no rollout ever hit.
+//
+//rollouts that go idle steps without breaking a tile have got the ball stuck
+//in a loop, and are called off as timeouts; so are the ones that run to steps.
+//with -o the heatmaps are also written out as prefix-stage<n>.ppm images (red
+//died, green cleared, gray timed out).
+//
+//this is headless, so it doesn't need Qt; build it on its own with i.e
+//
+//	g++ -std=c++14 -O2 -pthread clearability.cpp batchrunner.cpp world.cpp jobsystem.cpp body.cpp bodyset.cpp broadphase.cpp replaylog.cpp tilegrid.cpp sparsetiles.cpp levelfile.cpp chunkstore.cpp -o clearability
+//
+//and run it as "clearability [res] [seeds] [-steps n] [-idle n] [-pad speed] [-o prefix]"
+//(25x25 starts, 4 seeds, 400000 steps, idle after 100000, the pad at PAD_STEP).
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+
+#include "tilegrid.h"
+#include "levels.h"
+#include "batchrunner.h"
+
+using namespace std;
+
+const int OFFSETS = 100;//start offsets NextStage() can pick from, on each axis
+
+//the nth offset NextStage() can pick
+static double Offset(const int &n)
+{
+	return (n - 50.0) / 250.0;
+}
+
+//one cell of a heatmap
+static char Mark(const int &died, const int &cleared, const int &n)
+{
+	if( died == n )
+		return 'X';
+	if( died > 0 )
+		return 'x';
+	if( cleared == n )
+		return '#';
+	if( cleared == 0 )
+		return '.';
+	int tenths = cleared * 10 / n;
+	return (char)('0' + ((tenths < 1) ? 1 : tenths));
+}
+
+static bool SavePPM(const string &filename, const int &res, const vector< int > &died, const vector< int > &cleared, const int &n)
+{
+	const int SCALE = 8;//pixels per start
+	FILE *f = fopen(filename.c_str(), "wb");
+	if( f == NULL )
+		return false;
+	fprintf(f, "P6\n%d %d\n255\n", res*SCALE, res*SCALE);
+	for( int y = 0; y < res*SCALE; y++ )
+	{
+		for( int x = 0; x < res*SCALE; x++ )
+		{
+			int c = (y/SCALE)*res + x/SCALE;
+			int gray = 128 * (n - died[c] - cleared[c]) / n;
+			unsigned char rgb[3] = { (unsigned char)(gray + 127*died[c]/n), (unsigned char)(gray + 127*cleared[c]/n), (unsigned char)gray };
+			fwrite(rgb, 1, 3, f);
+		}
+	}
+	return fclose(f) == 0;
+}
+
+int main(int argc, char **argv)
+{
+	int res = 25, seeds = 4, padspeed = PAD_STEP;
+	long steps = 400000, idle = 100000;
+	string prefix;
+	for( int a = 1, n = 0; a < argc; a++ )
+	{
+		if( strcmp(argv[a], "-steps") == 0 && a+1 < argc )
+			steps = atol(argv[++a]);
+		else if( strcmp(argv[a], "-idle") == 0 && a+1 < argc )
+			idle = atol(argv[++a]);
+		else if( strcmp(argv[a], "-pad") == 0 && a+1 < argc )
+			padspeed = atoi(argv[++a]);
+		else if( strcmp(argv[a], "-o") == 0 && a+1 < argc )
+			prefix = argv[++a];
+		else if( n++ == 0 )
+			res = atoi(argv[a]);
+		else
+			seeds = atoi(argv[a]);
+	}
+	if( res < 1 ) res = 1;
+	if( res > OFFSETS ) res = OFFSETS;
+	if( seeds < 1 ) seeds = 1;
+
+	//the stages worth playing
+	vector< int > stages;
+	for( int s = 0; s < STAGES; s++ )
+	{
+		if( MAPSTR[s].find_first_not_of('0') != string::npos )
+			stages.push_back(s);
+	}
+
+	//every stage, start and seed; game g is stage g / (res*res*seeds), and so on
+	BatchRunner runner;
+	for( size_t s = 0; s < stages.size(); s++ )
+	{
+		for( int c = 0; c < res*res; c++ )
+		{
+			for( int e = 0; e < seeds; e++ )
+			{
+				BatchGame game;
+				game.level = MAPSTR[ stages[s] ];
+				game.seed = e + 1;
+				game.x = START_X + Offset( (c % res) * OFFSETS / res );
+				game.y = START_Y + Offset( (c / res) * OFFSETS / res );
+				game.padspeed = padspeed;
+				game.swept = 0;
+				game.fixed = 0;
+				game.single = 0;
+				game.steps = steps;
+				game.idle = idle;
+				runner.Add(game);
+			}
+		}
+	}
+
+	chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+	runner.Run();
+	double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+
+	long total = 0;
+	for( size_t g = 0; g < runner.results.size(); g++ )
+		total += runner.results[g].steps;
+	int games = (int)runner.games.size();
+	printf("%d rollouts (%d stages x %dx%d starts x %d seeds), %ld steps in %.1f s on %u threads: %.0f rollouts/min, %.2f M steps/s\n",
+		   games, (int)stages.size(), res, res, seeds, total, ms / 1000, thread::hardware_concurrency(), games * 60000.0 / ms, total / ms / 1000.0);
+
+	int per = res*res*seeds;
+	for( size_t s = 0; s < stages.size(); s++ )
+	{
+		const BatchResult *r = &runner.results[s*per];
+
+		int outcomes[GAME_OUTCOMES] = { 0 };
+		int stuck = 0;
+		vector< int > died(res*res, 0), cleared(res*res, 0);
+		vector< int > hit(r[0].cellhits.size(), 0);
+		for( int g = 0; g < per; g++ )
+		{
+			outcomes[ r[g].outcome ]++;
+			if( r[g].outcome == GAME_TIMEOUT && r[g].steps < steps )
+				stuck++;
+			died[g / seeds] += (r[g].outcome == GAME_DIED);
+			cleared[g / seeds] += (r[g].outcome == GAME_CLEARED);
+			for( size_t k = 0; k < hit.size(); k++ )
+				hit[k] += r[g].cellhits[k];
+		}
+
+		printf("\nstage %d: %.1f%% cleared, %.1f%% died, %.1f%% timed out (%d stuck in a loop)\n", stages[s],
+			   100.0 * outcomes[GAME_CLEARED] / per, 100.0 * outcomes[GAME_DIED] / per, 100.0 * outcomes[GAME_TIMEOUT] / per, stuck);
+
+		//the heatmap
+		printf("\n  dy \\ dx %+.3f%*s%+.3f\n", Offset(0), (res > 12) ? res - 12 : 1, "", Offset((res-1) * OFFSETS / res));
+		for( int y = 0; y < res; y++ )
+		{
+			printf("  %+.3f  ", Offset(y * OFFSETS / res));
+			for( int x = 0; x < res; x++ )
+				putchar( Mark(died[y*res + x], cleared[y*res + x], seeds) );
+			printf("\n");
+		}
+
+		if( !prefix.empty() )
+		{
+			char filename[64];
+			snprintf(filename, sizeof(filename), "-stage%d.ppm", stages[s]);
+			if( !SavePPM(prefix + filename, res, died, cleared, seeds) )
+				printf("  couldn't write %s%s\n", prefix.c_str(), filename);
+		}
+
+		//the tiles; 'o' was hit, '!' never was, '+' is the border
+		TileGrid g(8, 8, TILERAD, TILERAD);
+		g.Build();
+		g.SetTileStates(MAPSTR[ stages[s] ]);
+
+		string never;
+		printf("\n  tiles (o hit, ! never hit):\n");
+		for( int j = 0; j < g.fullrows; j++ )
+		{
+			printf("  ");
+			for( int i = 0; i < g.fullcols; i++ )
+			{
+				int k = g.Index(i, j);
+				int c = j*g.fullcols + i;
+				if( g.id[k] == TID_EMPTY )
+					putchar('.');
+				else if( i < 1 || g.cols < i || j < 1 || g.rows < j )
+					putchar('+');//the border; just walls
+				else if( hit[c] > 0 )
+					putchar('o');
+				else
+				{
+					putchar('!');
+					char cell[32];
+					snprintf(cell, sizeof(cell), " (%d,%d) ID %d", i, j, g.id[k]);
+					never += cell;
+				}
+			}
+			printf("\n");
+		}
+		printf("  %s\n", never.empty() ? "every tile was hit" : never.c_str());
+	}
+
+	return 0;
+}
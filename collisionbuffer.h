@@ -0,0 +1,65 @@
+//* collisionbuffer.h *//
+
+#ifndef COLLISIONBUFFER_H
+#define COLLISIONBUFFER_H
+
+#include <vector>
+
+const int COLLISION_EVENTS = 256;//collisions a World has room for in a step before its buffer has to grow
+
+const int EVENT_DIED = -2;//a CollisionEvent's other when it isn't a collision: body died (see BodyT::Die())
+
+//one collision, as it was recorded in the middle of a step
+struct CollisionEvent
+{
+	int body;//the body that collided (an index into the World's BodySet)
+	int other;//the body it hit, for a collision between two bodies; -1 otherwise, or EVENT_DIED
+	int i, j;//the cell of the tile it hit, as in TileRef; -1, -1 for anything that isn't a tile (i.e the pad)
+	double nx, ny;//the contact normal, pointing towards body
+	double impulse;//how hard it hit: the speed lost along the normal (0 if they were already moving apart)
+};
+
+//the collisions of one step, in the order they happened (see World::collisions),
+//and the bodies that died in it.
+//
+//the physics only records them here; what they lead to (a tile's HP, a tile
+//breaking, a sound, a game over) is left until the step is done. the events are allocated
+//up front and reused from step to step, so recording one is a store and an
+//increment; the buffer only grows when a step has more than it has room for.
+class CollisionBuffer
+{
+
+public:
+
+	CollisionBuffer() { count = 0; }
+	~CollisionBuffer() { }
+
+	void Reserve(const int &n) { if( (int)events.size() < n ) events.resize(n); }
+	void Clear() { count = 0; }
+
+	inline int Count() const { return count; }
+	inline const CollisionEvent& operator[](const int &q) const { return events[q]; }
+
+	inline void Add(const CollisionEvent &e)
+	{
+		if( count == (int)events.size() )
+			events.resize( count ? 2*count : COLLISION_EVENTS );
+		events[count++] = e;
+	}
+
+	inline void Add(const int &body, const int &other, const int &i, const int &j, const double &nx, const double &ny, const double &impulse)
+	{
+		CollisionEvent e = { body, other, i, j, nx, ny, impulse };
+		Add(e);
+	}
+
+	inline void AddDeath(const int &body) { Add(body, EVENT_DIED, -1, -1, 0, 0, 0); }
+
+private:
+
+	std::vector< CollisionEvent > events;
+	int count;//events[0 .. count-1] are this step's
+
+};
+
+#endif //COLLISIONBUFFER_H
@@ -0,0 +1,129 @@
+//* fixed.h *//
+
+#ifndef FIXED_H
+#define FIXED_H
+
+#include <stdint.h>
+#include <cmath>
+
+//a fixed-point number: a 64-bit integer counting 1/65536ths (48.16). it's the
+//scalar of BodyFixed (see body.h), for when a World has to come out the same
+//on every compiler and CPU (World::fixed): everything here is integer math,
+//so nothing depends on FMA contraction, x87 vs SSE, or the libm's sqrt.
+//
+//products and quotients are rounded to the nearest 1/65536th (halves away
+//from 0), using only shifts of non-negative numbers, so even the rounding is
+//the same everywhere. the range is far more than the board needs: a product
+//only overflows once it's past 2^31 or so, and the physics squares distances
+//of a few hundred pixels at most.
+//
+//16 fractional bits and at most 37 integer ones fit a double exactly, so a
+//Fixed can go through a double (i.e a BodySet, or a ReplayLog) and come back
+//unchanged.
+class Fixed
+{
+
+public:
+
+	static const int BITS = 16;
+	static const int64_t ONE = (int64_t)1 << BITS;
+
+	int64_t raw;//the value times ONE
+
+	constexpr Fixed() : raw(0) { }
+	constexpr Fixed(const int &i) : raw( (int64_t)i * ONE ) { }
+	explicit Fixed(const double &d) : raw( llround(d * ONE) ) { }//d*ONE is exact, and llround() rounds the same everywhere
+
+	static constexpr Fixed Raw(const int64_t &r) { Fixed f; f.raw = r; return f; }
+
+	explicit operator double() const { return (double)raw / ONE; }
+	explicit operator float() const { return (float)( (double)raw / ONE ); }
+	explicit operator int() const { return (int)(raw / ONE); }//toward 0, like (int) on a double
+
+	constexpr Fixed operator-() const { return Raw(-raw); }
+
+	friend constexpr Fixed operator+(const Fixed &a, const Fixed &b) { return Raw(a.raw + b.raw); }
+	friend constexpr Fixed operator-(const Fixed &a, const Fixed &b) { return Raw(a.raw - b.raw); }
+	friend constexpr Fixed operator*(const Fixed &a, const Fixed &b) { return Raw( Round(a.raw * b.raw) ); }
+
+	//a/0 is 0; the physics checks for 0 before it divides, so this only keeps a bad divide from trapping
+	friend Fixed operator/(const Fixed &a, const Fixed &b)
+	{
+		if( b.raw == 0 )
+			return Fixed();
+		int64_t n = a.raw * ONE;
+		int64_t un = (n < 0) ? -n : n;
+		int64_t ub = (b.raw < 0) ? -b.raw : b.raw;
+		int64_t q = (un + ub/2) / ub;
+		return Raw( ((n < 0) != (b.raw < 0)) ? -q : q );
+	}
+
+	Fixed& operator+=(const Fixed &b) { raw += b.raw; return *this; }
+	Fixed& operator-=(const Fixed &b) { raw -= b.raw; return *this; }
+	Fixed& operator*=(const Fixed &b) { return *this = *this * b; }
+	Fixed& operator/=(const Fixed &b) { return *this = *this / b; }
+
+	friend constexpr bool operator==(const Fixed &a, const Fixed &b) { return a.raw == b.raw; }
+	friend constexpr bool operator!=(const Fixed &a, const Fixed &b) { return a.raw != b.raw; }
+	friend constexpr bool operator<(const Fixed &a, const Fixed &b) { return a.raw < b.raw; }
+	friend constexpr bool operator>(const Fixed &a, const Fixed &b) { return a.raw > b.raw; }
+	friend constexpr bool operator<=(const Fixed &a, const Fixed &b) { return a.raw <= b.raw; }
+	friend constexpr bool operator>=(const Fixed &a, const Fixed &b) { return a.raw >= b.raw; }
+
+	//the math functions the physics uses, found by argument-dependent lookup in
+	//place of the <cmath> ones
+	friend constexpr Fixed abs(const Fixed &a) { return Raw( (a.raw < 0) ? -a.raw : a.raw ); }
+	friend constexpr Fixed fabs(const Fixed &a) { return abs(a); }
+
+	friend Fixed floor(const Fixed &a)
+	{
+		int64_t q = a.raw / ONE;
+		if( a.raw < q * ONE )
+			q--;//division rounds toward 0; floor rounds down
+		return Raw(q * ONE);
+	}
+
+	//the square root, to the nearest 1/65536th; 0 for anything <= 0
+	friend Fixed sqrt(const Fixed &a)
+	{
+		if( a.raw <= 0 )
+			return Fixed();
+		uint64_t n = (uint64_t)a.raw << BITS;//sqrt(raw/ONE)*ONE = sqrt(raw*ONE)
+		uint64_t r = ISqrt(n);
+		if( r*r + r < n )
+			r++;//n is past (r + 1/2)^2, so r+1 is nearer
+		return Raw( (int64_t)r );
+	}
+
+	//floor(sqrt(n)), one bit at a time
+	static uint64_t ISqrt(uint64_t n)
+	{
+		uint64_t r = 0;
+		uint64_t bit = (uint64_t)1 << 62;
+		while( bit > n )
+			bit >>= 2;
+		while( bit != 0 )
+		{
+			if( n >= r + bit )
+			{
+				n -= r + bit;
+				r = (r >> 1) + bit;
+			}
+			else
+				r >>= 1;
+			bit >>= 2;
+		}
+		return r;
+	}
+
+private:
+
+	//p / ONE, to the nearest integer, halves away from 0
+	static constexpr int64_t Round(const int64_t &p)
+	{
+		return (p < 0) ? -( (-p + ONE/2) >> BITS ) : ( (p + ONE/2) >> BITS );
+	}
+
+};
+
+#endif //FIXED_H
@@ -1,7 +1,6 @@
 #include <QTimer>
 #include <ctime>
 #include <QPainter>
-#include <QSound>
 #include <stdlib.h>
 
 #include "gameboard.h"
@@ -9,20 +8,22 @@
 #include "vector2.h"
 #include "mybutton.h"
 #include "pad.h"
+#include "body.h"
 #include "circle.h"
+#include "world.h"
+#include "tilegrid.h"
 #include "tilemap.h"
-#include "tilemapcell.h"
+#include "replaylog.h"
+#include "mixer.h"
+#include "mixerdevice.h"
 
 
 
 GameBoard::GameBoard(QWidget* parent)
 		: QWidget(parent), 
-		  bgm("bgm01.wav"), 
-		  bgm2("bgm02.wav"), 
 		  buttonicon("breakout.png"),
 		  buttonicon2("replay.png")
 {
-	srand( time(0) );
     //Constructor
     //setPalette(QPalette(QColor(200, 200, 200)));
     setFixedSize(640,480);
@@ -46,25 +47,40 @@ GameBoard::GameBoard(QWidget* parent)
     connect( replay, SIGNAL(clicked()), this, SLOT(Replay()) );
     
     pad = new Pad(this);
-    pad->submove( 200,377 );
+    pad->submove( PAD_X, PAD_Y );
     
-    tiles = new TileMap(8,8,TILERAD,TILERAD, this);//map is 10x10 tiles, minus a 1-tile border on each edge.
+    world = new World(8,8,TILERAD,TILERAD);//map is 10x10 tiles, minus a 1-tile border on each edge.
+	world->tiles->Build();
+	
+	//from here on, everything that goes into the world is logged (see ReplayLog)
+	recorder.Begin(world);
+	world->recorder = &recorder;
+	world->Seed( (unsigned int)time(0) );
+	
+    tiles = new TileMap(world->tiles, this);
 
 	//make a dynamic object
-	demoObj = new Circle( Vector2(72, 90) , OBJRAD, this);
-	demoObj->pos.x = 73.0;
-	demoObj->pos.y = 92.0;
-	
-	connect( demoObj, SIGNAL(died()), this, SLOT(end()));
+	demoBody = world->AddBody( Vector2(72, 90) , OBJRAD );
+	world->PlaceBody( demoBody, Vector2(73.0, 92.0), Vector2(72, 90) );
+	demoObj = new Circle( &world->bodies, demoBody, this );
 	
 	tiles->Build();
-	tiles->SetTileStates(MAPSTR[0]);
+	world->SetListener(this);
+	world->LoadLevel(MAPSTR[0]);
+	    
+	//every sound is decoded up front, so playing one never touches the disk
+	bgm[0] = mixer.Load("bgm01.wav");
+	bgm[1] = mixer.Load("bgm02.wav");
+	hit = mixer.Load("collision.wav");
+	speaker = new MixerDevice(&mixer, this);
+	speaker->Start();
 	    
     timer = new QTimer;
     connect(timer, SIGNAL(timeout()), this, SLOT(EnterFrame()));
     timer->start(10);
+    stepper.Start();
     
-    QSound::play("bgm01.wav");
+    PlayMusic(bgm[0]);
     
 	update();
 }
@@ -73,13 +89,15 @@ GameBoard::~GameBoard()
 {
     //Deconstructor
     timer->stop();
-//    bgm.setLoops(0);
-//    bgm.stop();
+    delete speaker;//before the mixer goes
     
     delete tiles;
     delete pad;
     delete demoObj;
     delete timer;
+    
+    recorder.Save(REPLAY_FILE);//play it back with the playback tool (playback.cpp)
+    delete world;
 }
 
 void GameBoard::paintEvent(QPaintEvent * /* event */)
@@ -90,11 +108,29 @@ void GameBoard::paintEvent(QPaintEvent * /* event */)
 	painter.drawPixmap(QRectF(0,0,640,480), bg[stage], QRectF(0,0,640,480));
 }
 
+//runs however many fixed physics steps have come due since the last frame, then
+//redraws; the physics rate doesn't depend on how regularly the timer fires.
 void GameBoard::EnterFrame()
 {
-	demoObj->IntegrateVerlet();
-	demoObj->CollideCirclevsTileMap( tiles->GetTile_V(demoObj->pos) );
-	demoObj->CollideCirclevsPad    ( pad, tiles->GetTile_V(demoObj->pos) );
+	world->padx = pad->x();
+	world->pady = pad->y();
+	world->padw = pad->width();
+	
+	int n = stepper.Frame();
+	for( int k = 0; k < n && timer->isActive(); k++ )//the game may end mid-frame
+	{
+		world->Step();
+	}
+	
+	demoObj->Sync();
+}
+
+//starts clip as the music, stopping whatever music was playing
+void GameBoard::PlayMusic(const int &clip)
+{
+	mixer.Stop(bgm[0]);
+	mixer.Stop(bgm[1]);
+	mixer.Play(clip);
 }
 
 void GameBoard::NextStage()
@@ -105,28 +141,27 @@ void GameBoard::NextStage()
 		
 		stage++; 
 		if( stage == 4 ) 
-			QSound::play("bgm01.wav");
+			PlayMusic(bgm[0]);
 		else
-			QSound::play("bgm02.wav");
+			PlayMusic(bgm[1]);
 			
-		demoObj->oldpos.x = 73.5;
-		demoObj->oldpos.y = 91.5;
-		demoObj->pos.x = 73.5 + (rand()%100-50.0) / 250.0;
-		demoObj->pos.y = 91.5 + (rand()%100-50.0) / 250.0;
+		double x = START_X + (world->rng.Next()%100-50.0) / 250.0;
+		double y = START_Y + (world->rng.Next()%100-50.0) / 250.0;
+		world->PlaceBody( demoBody, Vector2(x, y), Vector2(START_X, START_Y) );
 		
-		tiles->SetTileStates(MAPSTR[stage]);
+		world->LoadLevel(MAPSTR[stage]);
 		    
-	    connect(timer, SIGNAL(timeout()), this, SLOT(EnterFrame()));
-	    timer->start(10);
+	    timer->start(10);//(already connected in the constructor)
+	    stepper.Start();
 
 		update();		
 	}
 	else {
 		
 		timer->stop();
-		QSound::play("bgm01.wav");
+		PlayMusic(bgm[0]);
 		
-		tiles->SetTileStates(MAPSTR[stage]);
+		world->LoadLevel(MAPSTR[stage]);
 		    
 	    //connect(timer, SIGNAL(timeout()), this, SLOT(EnterFrame()));
 	    //timer->start(10);
@@ -147,4 +182,25 @@ void GameBoard::Replay()
 	stage = -1;
 	NextStage();
 }
-	
\ No newline at end of file
+
+//---- WorldListener; this is how the simulation reaches the widgets and the speakers
+
+void GameBoard::TileChanged(const TileRef &t)
+{
+	tiles->TileChanged(t);
+}
+
+void GameBoard::MapChanged(TileGrid * /* g */)
+{
+	tiles->MapChanged();
+}
+
+void GameBoard::BodyCollided(Body * /* b */, const TileRef & /* t */)
+{
+	mixer.Play(hit);//from the physics; it's only queued until the mixer's next Update()
+}
+
+void GameBoard::BodyDied(Body * /* b */)
+{
+	end();
+}
@@ -3,25 +3,35 @@
 
 #include <QWidget>
 #include <QPixmap>
-#include <QSound>
 #include <QPushButton>
 #include <cmath>
 #include <string>
 
+#include "worldlistener.h"
+#include "steptimer.h"
+#include "replaylog.h"
+#include "mixer.h"
+#include "levels.h"
+
 using namespace std;
 
+class World;
+template<class T> class BodyT;
+typedef BodyT< double > Body;
 class TileMap;
 //class MapLoader;
 class Circle;
 class QPixmap;
 class Pad;
 class MyButton;
-class Vector2;
+template<class T> class Vector2T;
+typedef Vector2T< double > Vector2;
 
 class QTimer;
+class MixerDevice;
 
 
-class GameBoard : public QWidget
+class GameBoard : public QWidget, public WorldListener
 {
     Q_OBJECT
 	
@@ -29,7 +39,6 @@ private:
 	
 	int stage;
 	QPixmap bg[5], buttonicon, buttonicon2;
-	QSound bgm, bgm2;
 	MyButton *startgame, *replay;
 	
 private slots:
@@ -46,17 +55,37 @@ public:
     
     Pad *pad;
 
+	World *world;//everything physical lives in here; the widgets below only draw it
+
 	TileMap *tiles;
 
+	int demoBody;//index into world->bodies
 	Circle *demoObj;
 
-	QTimer *timer;
+	QTimer *timer;//drives the frames; how many physics steps each one runs is up to stepper
+	StepTimer stepper;
+
+	ReplayLog recorder;//this session, saved to REPLAY_FILE on exit
+
+	Mixer mixer;//every sound, decoded once when the game starts
+	MixerDevice *speaker;//plays the mixer
+	int bgm[2];//clips in the mixer
+	int hit;
+
+	void PlayMusic(const int &clip);
     
 public slots:
 	void NextStage();
 	void Replay();
 	void end();
 
+public:
+	//WorldListener
+	void TileChanged(const TileRef &t);
+	void MapChanged(TileGrid *g);
+	void BodyCollided(Body *b, const TileRef &t);
+	void BodyDied(Body *b);
+
 signals:
 
 };
@@ -79,18 +108,11 @@ const int XMAX = 400;
 const int YMIN = 0;
 const int YMAX = 400;
 
-const int TILERAD = 20;
-const int OBJRAD = 16;
-
 const double OBJSPEED = 0.2;
 const double MAXSPEED = 20;
 
+const char REPLAY_FILE[] = "session.rpl";//where the last session's ReplayLog goes
 
-//demo level
-const string MAPSTR[] = { "0000000000000000000000000000000000000000000000000000000000000000",
-						  "A6E00002000?E000000NA0070C0N00;10B0N00:10>0>L0060000F000@0GH0003",
-						  "A3C0002100;?FNN00000000000000273692ACDEFGHI0000000000000@?:;0088",
-						  "B0000012000;HHJKAAABB390000000000000083502030420000BBCCDDEEFF000" };
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
 
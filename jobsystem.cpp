@@ -0,0 +1,146 @@
+//* jobsystem.cpp *//
+
+#include <vector>
+#include <deque>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+#include "jobsystem.h"
+
+using namespace std;
+
+//starts threads-1 worker threads (the thread calling Run() is the other one);
+//one per core if threads is 0
+JobSystem::JobSystem(const int &threads_in)
+	: pending(0)
+{
+	int n = threads_in;
+	if( n <= 0 )
+		n = (int)thread::hardware_concurrency();
+	if( n <= 0 )
+		n = 1;
+
+	run = 0;
+	quit = 0;
+	list = NULL;
+
+	for( int w = 0; w < n; w++ )
+	{
+		workers.push_back( new JobWorker() );
+		workers[w]->done = 0;
+		workers[w]->stolen = 0;
+	}
+	for( int w = 1; w < n; w++ )
+		threads.push_back( thread(&JobSystem::Work, this, w) );
+}
+
+JobSystem::~JobSystem()
+{
+	{
+		lock_guard< mutex > guard(lock);
+		quit = 1;
+	}
+	wake.notify_all();
+	for( size_t t = 0; t < threads.size(); t++ )
+		threads[t].join();
+
+	for( size_t w = 0; w < workers.size(); w++ )
+		delete workers[w];
+}
+
+//runs list's jobs 0 .. jobs-1 on every thread, this one included, and returns
+//once they're all done. only one Run() at a time.
+void JobSystem::Run(JobList *list_in, const int &jobs)
+{
+	if( jobs <= 0 )
+		return;
+
+	//set before any job is queued; a worker only looks at it once it has one
+	list = list_in;
+	pending = jobs;
+
+	int n = Threads();
+	for( int w = 0; w < n; w++ )
+	{
+		lock_guard< mutex > guard(workers[w]->lock);
+		for( int j = (int)((long)jobs*w/n); j < (int)((long)jobs*(w+1)/n); j++ )
+			workers[w]->jobs.push_back(j);
+	}
+
+	{
+		lock_guard< mutex > guard(lock);
+		run++;
+	}
+	wake.notify_all();
+
+	int job;
+	while( 0 < pending.load() )
+	{
+		if( Next(0, job) )
+		{
+			list->Do(job);
+			workers[0]->done++;
+			pending--;
+		}
+		else
+			this_thread::yield();//the last jobs are running elsewhere
+	}
+}
+
+//worker w's thread: sleeps until there's a new run, then works until there's nothing left to take
+void JobSystem::Work(const int &w)
+{
+	unsigned int seen = 0;
+	for( ;; )
+	{
+		{
+			unique_lock< mutex > guard(lock);
+			while( !quit && run == seen )
+				wake.wait(guard);
+			if( quit )
+				return;
+			seen = run;
+		}
+
+		int job;
+		while( Next(w, job) )
+		{
+			list->Do(job);
+			workers[w]->done++;
+			pending--;
+		}
+	}
+}
+
+//finds worker w its next job: the last of its own, or else the first of
+//someone else's. returns 0 if every deque is empty.
+int JobSystem::Next(const int &w, int &job)
+{
+	JobWorker *me = workers[w];
+	{
+		lock_guard< mutex > guard(me->lock);
+		if( !me->jobs.empty() )
+		{
+			job = me->jobs.back();
+			me->jobs.pop_back();
+			return 1;
+		}
+	}
+
+	int n = Threads();
+	for( int v = 1; v < n; v++ )
+	{
+		JobWorker *other = workers[(w + v) % n];
+		lock_guard< mutex > guard(other->lock);
+		if( !other->jobs.empty() )
+		{
+			job = other->jobs.front();
+			other->jobs.pop_front();
+			me->stolen++;
+			return 1;
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,77 @@
+//* jobsystem.h *//
+
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+#include <vector>
+#include <deque>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+//a batch of jobs for a JobSystem to run; job is an index in [0, jobs), and
+//Do() is called exactly once for each, on whichever thread gets to it
+class JobList
+{
+public:
+	virtual ~JobList() { }
+
+	virtual void Do(const int &job) = 0;
+};
+
+//one thread of a JobSystem, and the jobs it has queued
+struct JobWorker
+{
+	std::mutex lock;
+	std::deque< int > jobs;//the owner takes from the back; thieves take from the front
+
+	long done;//stats: jobs this worker ran,
+	long stolen;//and how many of those it took off another worker
+};
+
+//a pool of threads that runs JobLists, stealing work from each other.
+//
+//Run() deals the jobs out to every worker's deque in contiguous runs and joins
+//in itself, as worker 0. a worker runs its own jobs from the back of its deque,
+//and when it runs out, takes jobs off the front of the others', so one long job
+//doesn't leave the rest of a run waiting behind it. the threads are started
+//once and sleep between runs.
+//
+//it doesn't decide what runs in parallel; the JobList has to make its jobs
+//independent of each other (see World::ResolveParallel()).
+class JobSystem
+{
+
+public:
+
+	std::vector< JobWorker* > workers;
+
+	JobSystem(const int &threads = 0);
+	~JobSystem();
+
+	inline int Threads() const { return (int)workers.size(); }
+
+	void Run(JobList *list, const int &jobs);
+
+private:
+
+	std::vector< std::thread > threads;
+
+	std::mutex lock;//guards run and quit, for the sleeping workers
+	std::condition_variable wake;
+	unsigned int run;//Run()s so far
+	int quit;
+
+	JobList *list;//what's running
+	std::atomic< int > pending;//its jobs not done yet
+
+	void Work(const int &w);
+	int Next(const int &w, int &job);
+
+	JobSystem(const JobSystem&);
+	JobSystem& operator=(const JobSystem&);
+
+};
+
+#endif //JOBSYSTEM_H
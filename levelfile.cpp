@@ -0,0 +1,218 @@
+//* levelfile.cpp *//
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define LEVEL_MMAP 1
+#endif
+
+#include "tilegrid.h"
+#include "levelfile.h"
+
+using namespace std;
+
+static unsigned int GetU32(const unsigned char *p)
+{
+	return p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned int)p[3] << 24);
+}
+
+static void PutU32(unsigned char *p, const unsigned int &v)
+{
+	p[0] = v & 0xFF;
+	p[1] = (v >> 8) & 0xFF;
+	p[2] = (v >> 16) & 0xFF;
+	p[3] = (v >> 24) & 0xFF;
+}
+
+LevelFile::LevelFile()
+{
+	data = NULL;
+	size = 0;
+	mapped = 0;
+	version = rows = cols = xw = yw = 0;
+}
+
+LevelFile::~LevelFile()
+{
+	Close();
+}
+
+//maps filename and checks that it's a level we understand
+bool LevelFile::Open(const string &filename)
+{
+	Close();
+
+#if defined(LEVEL_MMAP)
+	int fd = open(filename.c_str(), O_RDONLY);
+	if( fd < 0 )
+		return false;
+
+	struct stat st;
+	if( fstat(fd, &st) == 0 && LEVEL_HEADER <= st.st_size )
+	{
+		void *p = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+		if( p != MAP_FAILED )
+		{
+			data = (unsigned char*)p;
+			size = st.st_size;
+			mapped = 1;
+		}
+	}
+	close(fd);//the mapping stays valid
+#else
+	FILE *f = fopen(filename.c_str(), "rb");
+	if( f == NULL )
+		return false;
+
+	fseek(f, 0, SEEK_END);
+	long n = ftell(f);
+	fseek(f, 0, SEEK_SET);
+	if( LEVEL_HEADER <= n )
+	{
+		data = (unsigned char*)malloc(n);
+		if( data != NULL && fread(data, 1, n, f) == (size_t)n )
+			size = n;
+		else
+		{
+			free(data);
+			data = NULL;
+		}
+	}
+	fclose(f);
+#endif
+
+	if( data == NULL )
+		return false;
+
+	version = GetU32(data + 4);
+	rows = GetU32(data + 8);
+	cols = GetU32(data + 12);
+	xw = GetU32(data + 16);
+	yw = GetU32(data + 20);
+
+	if( memcmp(data, "BLVL", 4) != 0 || version != LEVEL_VERSION )
+	{
+		//"LevelFile::Open(): not a level, or a version we can't read"
+		Close();
+		return false;
+	}
+
+	//the header words are read as unsigned, so anything past INT_MAX comes out
+	//negative here and is caught by the same checks
+	if( rows <= 0 || LEVEL_MAXSIDE < rows || cols <= 0 || LEVEL_MAXSIDE < cols ||
+		xw <= 0 || LEVEL_MAXHALFWIDTH < xw || yw <= 0 || LEVEL_MAXHALFWIDTH < yw )
+	{
+		//"LevelFile::Open(): the level's size is out of range"
+		Close();
+		return false;
+	}
+
+	size_t need = LEVEL_HEADER + (size_t)LEVEL_PLANES * ((size_t)rows+2) * ((size_t)cols+2);
+	if( size < need || !PlanesValid() )
+	{
+		//"LevelFile::Open(): the level is cut short, or its planes are damaged"
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+//one pass over the planes a TileGrid would trust: every ID has to be one the
+//shape, edge and projection tables have a row for, every edge state has to be
+//one of the EDGE_IDs, and every tile that can break has to have HP to lose
+bool LevelFile::PlanesValid() const
+{
+	size_t n = ((size_t)rows+2) * ((size_t)cols+2);
+	const unsigned char *id = data + LEVEL_HEADER;
+	const unsigned char *edges = id + 2*n;
+	const unsigned char *hp = id + 4*n;
+	const unsigned char *mat = id + 5*n;
+
+	for( size_t k = 0; k < n; k++ )
+	{
+		if( TID_COUNT <= id[k] )
+			return false;
+
+		for( int s = ESHIFT_U; s <= ESHIFT_R; s += 2 )
+		{
+			if( EID_SOLID < ((edges[k] >> s) & 3) )
+				return false;
+		}
+
+		if( id[k] != TID_EMPTY && !(mat[k] & MAT_UNBREAKABLE) && (hp[k] < 1 || LEVEL_MAXHP < hp[k]) )
+			return false;
+	}
+
+	return true;
+}
+
+void LevelFile::Close()
+{
+	if( data != NULL )
+	{
+#if defined(LEVEL_MMAP)
+		if( mapped )
+			munmap(data, size);
+		else
+			free(data);
+#else
+		free(data);
+#endif
+	}
+	data = NULL;
+	size = 0;
+	mapped = 0;
+}
+
+//writes grid as a level file; the planes are written straight out of the grid
+bool LevelFile::Write(const string &filename, const TileGrid &grid)
+{
+	unsigned char header[LEVEL_HEADER];
+	memset(header, 0, sizeof(header));
+	memcpy(header, "BLVL", 4);
+	PutU32(header + 4, LEVEL_VERSION);
+	PutU32(header + 8, grid.rows);
+	PutU32(header + 12, grid.cols);
+	PutU32(header + 16, grid.xw);
+	PutU32(header + 20, grid.yw);
+
+	FILE *f = fopen(filename.c_str(), "wb");
+	if( f == NULL )
+		return false;
+
+	size_t n = grid.Count();
+	const unsigned char *planes[LEVEL_PLANES] = { grid.id, grid.ctype, grid.edges, grid.signs, grid.hp, grid.mat };
+
+	bool ok = ( fwrite(header, 1, LEVEL_HEADER, f) == (size_t)LEVEL_HEADER );
+	if( grid.sparse == NULL )
+	{
+		for( int p = 0; p < LEVEL_PLANES && ok; p++ )
+		{
+			ok = ( fwrite(planes[p], 1, n, f) == n );
+		}
+	}
+	else
+	{
+		//a sparse grid is written out dense, a row at a time; the file is the same either way
+		vector< unsigned char > row(grid.fullcols);
+		for( int p = 0; p < LEVEL_PLANES && ok; p++ )
+		{
+			for( int j = 0; j < grid.fullrows && ok; j++ )
+			{
+				for( int i = 0; i < grid.fullcols; i++ )
+					row[i] = planes[p][ grid.Index(i, j) ];
+				ok = ( fwrite(&row[0], 1, row.size(), f) == row.size() );
+			}
+		}
+	}
+
+	return (fclose(f) == 0) && ok;
+}
@@ -0,0 +1,66 @@
+//* levelfile.h *//
+
+#ifndef LEVELFILE_H
+#define LEVELFILE_H
+
+#include <string>
+#include <cstddef>
+
+class TileGrid;
+
+//a level on disk, laid out exactly like a TileGrid in memory so that it can be
+//mapped and used in place, with nothing to parse or recompute (only to check):
+//
+//	header, LEVEL_HEADER bytes; "BLVL", then u32 (little-endian) version, rows,
+//	cols, xw, yw, and 2 reserved words
+//	6 planes of (rows+2)*(cols+2) bytes each, border cells included, in the order
+//	id, ctype, edges, signs, hp, mat (see TileGrid for what they hold)
+//
+//the mapping is private (copy-on-write): the game can break tiles in a mapped
+//level without the file changing. where mmap() isn't available, the file is
+//read into memory instead.
+//
+//since the planes are used as they are, Open() checks every value the game
+//indexes tables with (IDs, edge states) or counts down (HP) before it takes a file.
+const int LEVEL_VERSION = 1;
+const int LEVEL_HEADER = 32;//bytes
+const int LEVEL_PLANES = 6;
+const int LEVEL_MAXSIDE = 1 << 14;//rows, cols; keeps LEVEL_PLANES*Count() well inside an int
+const int LEVEL_MAXHALFWIDTH = 1 << 10;//xw, yw; keeps the world bounds inside an int
+const int LEVEL_MAXHP = 8;//the most HP RollColor() gives a tile
+
+class LevelFile
+{
+
+public:
+
+	unsigned char *data;//the whole file
+	size_t size;
+	int mapped;//data is an mmap (otherwise it was read into memory)
+
+	int version;
+	int rows;
+	int cols;
+	int xw;
+	int yw;
+
+	LevelFile();
+	~LevelFile();
+
+	bool Open(const std::string &filename);
+	void Close();
+
+	inline unsigned char* Planes() { return data + LEVEL_HEADER; }
+
+	static bool Write(const std::string &filename, const TileGrid &grid);
+
+private:
+
+	bool PlanesValid() const;
+
+	LevelFile(const LevelFile&);//not copyable; it owns the mapping
+	LevelFile& operator=(const LevelFile&);
+
+};
+
+#endif //LEVELFILE_H
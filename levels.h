@@ -0,0 +1,33 @@
+//* levels.h *//
+
+#ifndef LEVELS_H
+#define LEVELS_H
+
+#include <string>
+
+//the game's stages, and where everything is put at the start of one. none of
+//this needs Qt, so headless tools (i.e batch.cpp) can set a World up exactly
+//the way the GameBoard does.
+
+const int TILERAD = 20;
+const int OBJRAD = 16;
+
+const double START_X = 73.5;//where NextStage() puts the ball back (give or take 0.2), moving
+const double START_Y = 91.5;//from here, so its first step is the difference
+
+const int PAD_X = 200;//where the Pad starts
+const int PAD_Y = 377;
+const int PAD_W = 72;//and its width
+const int PAD_MINX = 55;//as far as the keys can move it
+const int PAD_MAXX = 305;
+const int PAD_STEP = 5;//pixels per key press
+
+
+//demo level
+const std::string MAPSTR[] = { "0000000000000000000000000000000000000000000000000000000000000000",
+							   "A6E00002000?E000000NA0070C0N00;10B0N00:10>0>L0060000F000@0GH0003",
+							   "A3C0002100;?FNN00000000000000273692ACDEFGHI0000000000000@?:;0088",
+							   "B0000012000;HHJKAAABB390000000000000083502030420000BBCCDDEEFF000" };
+const int STAGES = sizeof(MAPSTR) / sizeof(MAPSTR[0]);
+
+#endif //LEVELS_H
@@ -0,0 +1,320 @@
+//* mixer.cpp *//
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <string>
+#include <atomic>
+
+#include "mixer.h"
+
+using namespace std;
+
+static unsigned int GetU32(const unsigned char *p)
+{
+	return (unsigned int)p[0] | ((unsigned int)p[1] << 8) | ((unsigned int)p[2] << 16) | ((unsigned int)p[3] << 24);
+}
+
+static int GetU16(const unsigned char *p)
+{
+	return p[0] | (p[1] << 8);
+}
+
+//reads and decodes a .wav file; see DecodeWav()
+bool LoadWav(const string &filename, SoundClip &clip)
+{
+	FILE *f = fopen(filename.c_str(), "rb");
+	if( f == NULL )
+		return false;
+
+	vector< unsigned char > data;
+	unsigned char block[4096];
+	size_t n;
+	while( (n = fread(block, 1, sizeof(block), f)) > 0 )
+		data.insert(data.end(), block, block + n);
+	fclose(f);
+
+	return !data.empty() && DecodeWav(&data[0], data.size(), clip);
+}
+
+//decodes an uncompressed (PCM) .wav held in memory, 8 or 16 bits, mono or
+//stereo, at any rate, into 16-bit stereo at MIX_RATE (resampled linearly).
+//returns false if it isn't one of those.
+bool DecodeWav(const unsigned char *data, const size_t &size, SoundClip &clip)
+{
+	if( size < 12 || memcmp(data, "RIFF", 4) != 0 || memcmp(data + 8, "WAVE", 4) != 0 )
+		return false;
+
+	int format = 0, channels = 0, rate = 0, bits = 0;
+	const unsigned char *pcm = NULL;
+	size_t pcmsize = 0;
+
+	//walk the chunks; "fmt " says what the samples are, "data" holds them
+	size_t p = 12;
+	while( p + 8 <= size )
+	{
+		size_t len = GetU32(data + p + 4);
+		const unsigned char *body = data + p + 8;
+		if( size - (p + 8) < len )
+			len = size - (p + 8);//a truncated file; take what's there
+
+		if( memcmp(data + p, "fmt ", 4) == 0 && len >= 16 )
+		{
+			format = GetU16(body);
+			channels = GetU16(body + 2);
+			rate = (int)GetU32(body + 4);
+			bits = GetU16(body + 14);
+		}
+		else if( memcmp(data + p, "data", 4) == 0 )
+		{
+			pcm = body;
+			pcmsize = len;
+		}
+		p += 8 + len + (len & 1);//chunks are padded to even sizes
+	}
+
+	if( format != 1 || (channels != 1 && channels != 2) || (bits != 8 && bits != 16) || rate <= 0 || pcm == NULL )
+		return false;
+
+	//to 16-bit samples, as they are
+	int bytes = bits / 8;
+	int inframes = (int)(pcmsize / (bytes*channels));
+	vector< short > in(inframes*channels);
+	for( int s = 0; s < inframes*channels; s++ )
+	{
+		if( bits == 8 )
+			in[s] = (short)((pcm[s] - 128) << 8);//8-bit samples are unsigned
+		else
+			in[s] = (short)GetU16(pcm + 2*s);
+	}
+
+	//then to stereo at MIX_RATE
+	int outframes = (int)((long long)inframes * MIX_RATE / rate);
+	clip.frames.assign(outframes*MIX_CHANNELS, 0);
+	for( int f = 0; f < outframes; f++ )
+	{
+		long long at = (long long)f * rate;//position in the input, in 1/MIX_RATE frames
+		int f0 = (int)(at / MIX_RATE);
+		int f1 = (f0 + 1 < inframes) ? f0 + 1 : f0;
+		int t = (int)(at % MIX_RATE);
+
+		for( int c = 0; c < MIX_CHANNELS; c++ )
+		{
+			int ic = (channels == 1) ? 0 : c;
+			int a = in[f0*channels + ic];
+			int b = in[f1*channels + ic];
+			clip.frames[f*MIX_CHANNELS + c] = (short)(a + (long long)(b - a) * t / MIX_RATE);
+		}
+	}
+	return true;
+}
+
+
+//=============================== Mixer ====================================
+
+Mixer::Mixer()
+	: written(0), consumed(0), pushed(0), popped(0), dropped(0), underruns(0)
+{
+	for( int v = 0; v < MIX_VOICES; v++ )
+	{
+		voices[v].clip = -1;
+		voices[v].pos = 0;
+		voices[v].gain = 0;
+		voices[v].started = 0;
+	}
+	memset(ring, 0, sizeof(ring));
+
+	clock = 0;
+	stolen = 0;
+}
+
+//decodes a .wav file into a new clip; returns its index (for Play()), or -1 if
+//the file can't be read. call this before the mixing starts.
+int Mixer::Load(const string &filename)
+{
+	SoundClip clip;
+	if( !LoadWav(filename, clip) )
+		return -1;
+	return Add(clip);
+}
+
+//adds a clip that's already decoded; returns its index
+int Mixer::Add(const SoundClip &clip)
+{
+	clips.push_back(clip);
+	return (int)clips.size() - 1;
+}
+
+//asks for clip to be started at the next Update(), at gain/MIX_UNITY of its
+//volume. this is the only call that's safe from another thread (one at a
+//time); it never blocks, and returns false (dropping the request) if the queue
+//is full.
+bool Mixer::Play(const int &clip, const int &gain)
+{
+	if( clip < 0 || clip >= (int)clips.size() )
+		return false;
+
+	unsigned int p = pushed.load(memory_order_relaxed);
+	if( p - popped.load(memory_order_acquire) >= (unsigned int)MIX_TRIGGERS )
+	{
+		dropped++;
+		return false;
+	}
+
+	triggers[p & (MIX_TRIGGERS-1)].clip = clip;
+	triggers[p & (MIX_TRIGGERS-1)].gain = gain;
+	pushed.store(p + 1, memory_order_release);
+	return true;
+}
+
+//silences every voice playing clip (i.e the music, when the stage changes);
+//call this from the mixing thread, like Update()
+void Mixer::Stop(const int &clip)
+{
+	for( int v = 0; v < MIX_VOICES; v++ )
+	{
+		if( voices[v].clip == clip )
+			voices[v].clip = -1;
+	}
+}
+
+//starts the sounds Play() queued, and tops the ring up to MIX_AHEAD frames
+void Mixer::Update()
+{
+	unsigned int q = popped.load(memory_order_relaxed);
+	unsigned int end = pushed.load(memory_order_acquire);
+	for( ; q != end; q++ )
+	{
+		Start( triggers[q & (MIX_TRIGGERS-1)] );
+	}
+	popped.store(q, memory_order_release);
+
+	unsigned int w = written.load(memory_order_relaxed);
+	int want = MIX_AHEAD - (int)(w - consumed.load(memory_order_acquire));
+	while( want > 0 )
+	{
+		//up to the end of the ring, then around again
+		int at = (int)(w & (MIX_RING-1));
+		int n = (want < MIX_RING - at) ? want : MIX_RING - at;
+		Mix(ring + at*MIX_CHANNELS, n);
+		w += n;
+		want -= n;
+	}
+	written.store(w, memory_order_release);
+}
+
+//takes up to frames frames out of the ring into out (interleaved); if there
+//aren't that many, the rest is silence. returns how many came from the ring.
+//this is what the audio device calls, on its own thread.
+int Mixer::Read(short *out, const int &frames)
+{
+	unsigned int r = consumed.load(memory_order_relaxed);
+	int have = (int)(written.load(memory_order_acquire) - r);
+	int n = (frames < have) ? frames : have;
+
+	for( int f = 0; f < n; )
+	{
+		int at = (int)((r + f) & (MIX_RING-1));
+		int run = (n - f < MIX_RING - at) ? n - f : MIX_RING - at;
+		memcpy(out + f*MIX_CHANNELS, ring + at*MIX_CHANNELS, run*MIX_CHANNELS*sizeof(short));
+		f += run;
+	}
+	if( n < frames )
+	{
+		memset(out + n*MIX_CHANNELS, 0, (frames - n)*MIX_CHANNELS*sizeof(short));
+		underruns++;
+	}
+
+	consumed.store(r + n, memory_order_release);
+	return n;
+}
+
+//gives t a voice: a free one, or else the one that's been playing longest
+void Mixer::Start(const Trigger &t)
+{
+	int best = 0;
+	for( int v = 0; v < MIX_VOICES; v++ )
+	{
+		if( voices[v].clip < 0 )
+		{
+			best = v;
+			break;
+		}
+		if( voices[v].started < voices[best].started )
+			best = v;
+	}
+	if( voices[best].clip >= 0 )
+		stolen++;
+
+	voices[best].clip = t.clip;
+	voices[best].pos = 0;
+	voices[best].gain = t.gain;
+	voices[best].started = ++clock;
+}
+
+//mixes every playing voice into frames frames of out; voices that reach the
+//end of their clip are freed
+void Mixer::Mix(short *out, const int &frames)
+{
+	sum.assign(frames*MIX_CHANNELS, 0);
+
+	for( int v = 0; v < MIX_VOICES; v++ )
+	{
+		Voice &voice = voices[v];
+		if( voice.clip < 0 )
+			continue;
+
+		const SoundClip &clip = clips[voice.clip];
+		int n = clip.Length() - voice.pos;
+		if( frames < n )
+			n = frames;
+
+		if( 0 < n )
+		{
+			const short *src = &clip.frames[0] + voice.pos*MIX_CHANNELS;
+			for( int s = 0; s < n*MIX_CHANNELS; s++ )
+				sum[s] += src[s] * voice.gain;
+			voice.pos += n;
+		}
+		if( voice.pos >= clip.Length() )
+			voice.clip = -1;
+	}
+
+	for( int s = 0; s < frames*MIX_CHANNELS; s++ )
+	{
+		int x = sum[s] / MIX_UNITY;
+		out[s] = (short)( (x < -32768) ? -32768 : (x > 32767) ? 32767 : x );
+	}
+}
+
+
+//=============================== NullSink ====================================
+
+NullSink::NullSink(Mixer *mixer_in)
+{
+	mixer = mixer_in;
+	frames = 0;
+	loud = 0;
+	peak = 0;
+}
+
+//takes n frames from the mixer, as a device asking for its next buffer would
+void NullSink::Pull(const int &n)
+{
+	buffer.resize(n*MIX_CHANNELS);
+	mixer->Read(&buffer[0], n);
+
+	for( int f = 0; f < n; f++ )
+	{
+		int l = 0;
+		for( int c = 0; c < MIX_CHANNELS; c++ )
+		{
+			int s = buffer[f*MIX_CHANNELS + c];
+			if( s < 0 ) s = -s;
+			if( peak < s ) peak = s;
+			l |= s;
+		}
+		loud += (l != 0);
+	}
+	frames += n;
+}
@@ -0,0 +1,124 @@
+//* mixer.h *//
+
+#ifndef MIXER_H
+#define MIXER_H
+
+#include <vector>
+#include <string>
+#include <atomic>
+
+const int MIX_RATE = 44100;//frames per second; every clip is converted to this when it's loaded
+const int MIX_CHANNELS = 2;
+const int MIX_VOICES = 16;//sounds that can play at once
+const int MIX_RING = 4096;//frames in the ring buffer; a power of 2
+const int MIX_AHEAD = 1024;//frames Update() keeps mixed ahead of the device (about 23 ms)
+const int MIX_TRIGGERS = 256;//Play()s that can be waiting for the next Update(); a power of 2
+const int MIX_UNITY = 256;//gain of a sound played at its own volume
+
+//a decoded sound: 16-bit stereo at MIX_RATE, interleaved
+struct SoundClip
+{
+	std::vector< short > frames;
+
+	inline int Length() const { return (int)frames.size() / MIX_CHANNELS; }//in frames
+};
+
+//one sound playing
+struct Voice
+{
+	int clip;//index into Mixer::clips, or -1 if the voice is free
+	int pos;//next frame of the clip
+	int gain;
+	unsigned int started;//when it started, so the oldest voice can be taken if they're all busy
+};
+
+//a request to start a sound, on its way from Play() to Update()
+struct Trigger
+{
+	int clip;
+	int gain;
+};
+
+//an in-process software mixer, so sounds start right away and never need the
+//filesystem during the game.
+//
+//every sound is decoded once, up front, into a SoundClip (Load()). Play() can be
+//called from any one thread (i.e the physics); it only drops the request into a
+//lock-free queue. Update(), on the mixing thread (i.e once per frame), starts
+//the queued sounds on a fixed pool of voices, taking the oldest voice if they're
+//all busy, and mixes them into a ring buffer until it holds MIX_AHEAD frames.
+//the audio device (or a NullSink) takes frames from the ring with Read(), on
+//its own thread; if the ring runs dry it gets silence and an underrun is counted.
+//
+//the trigger queue and the ring each have exactly one writer and one reader, so
+//a pair of atomic counters (never wrapped, masked on use) is all they need.
+class Mixer
+{
+
+public:
+
+	std::vector< SoundClip > clips;
+	Voice voices[MIX_VOICES];
+
+	short ring[MIX_RING*MIX_CHANNELS];
+	std::atomic< unsigned int > written;//frames ever mixed into the ring
+	std::atomic< unsigned int > consumed;//frames ever taken out of it
+
+	Trigger triggers[MIX_TRIGGERS];
+	std::atomic< unsigned int > pushed;//Play()s ever queued
+	std::atomic< unsigned int > popped;//of those, ever started
+
+	unsigned int clock;//voices started
+	std::atomic< int > dropped;//stats: Play()s lost because the queue was full,
+	int stolen;//voices cut short to play something else,
+	std::atomic< int > underruns;//and Read()s the ring couldn't fill
+
+	Mixer();
+	~Mixer() { }
+
+	int Load(const std::string &filename);
+	int Add(const SoundClip &clip);
+
+	bool Play(const int &clip, const int &gain = MIX_UNITY);
+	void Stop(const int &clip);
+	void Update();
+	int Read(short *out, const int &frames);
+
+	inline int Queued() const { return (int)(written.load() - consumed.load()); }//frames mixed, not yet read
+
+private:
+
+	std::vector< int > sum;//scratch for Mix()
+
+	void Start(const Trigger &t);
+	void Mix(short *out, const int &frames);
+
+	Mixer(const Mixer&);
+	Mixer& operator=(const Mixer&);
+
+};
+
+bool LoadWav(const std::string &filename, SoundClip &clip);
+bool DecodeWav(const unsigned char *data, const size_t &size, SoundClip &clip);
+
+//an audio device that plays nothing: it takes frames from a Mixer the way a
+//real one would, so the mixer can run (and be checked) without a sound card
+class NullSink
+{
+
+public:
+
+	Mixer *mixer;
+	std::vector< short > buffer;//what the last Pull() got
+
+	long frames;//frames pulled
+	long loud;//of those, frames that weren't silent
+	int peak;//loudest sample
+
+	NullSink(Mixer *mixer_in);
+
+	void Pull(const int &n);
+
+};
+
+#endif //MIXER_H
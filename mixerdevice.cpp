@@ -0,0 +1,81 @@
+//* mixerdevice.cpp *//
+
+#include <QIODevice>
+#include <QTimer>
+#include <QAudioFormat>
+#include <QAudioOutput>
+
+#include "mixer.h"
+#include "mixerdevice.h"
+
+MixerDevice::MixerDevice(Mixer *mixer_in, QObject *parent)
+	:QIODevice(parent)
+{
+	mixer = mixer_in;
+	output = NULL;
+	pump = NULL;
+}
+
+MixerDevice::~MixerDevice()
+{
+	Stop();
+}
+
+//opens the sound card and starts pulling from the mixer; returns false if there's
+//no output that can play the mixer's format (the game then just runs silent)
+bool MixerDevice::Start()
+{
+	QAudioFormat format;
+	format.setSampleRate(MIX_RATE);
+	format.setChannelCount(MIX_CHANNELS);
+	format.setSampleSize(16);
+	format.setCodec("audio/pcm");
+	format.setByteOrder(QAudioFormat::LittleEndian);
+	format.setSampleType(QAudioFormat::SignedInt);
+
+	output = new QAudioOutput(format, this);
+	output->setBufferSize( MIX_AHEAD/2 * MIX_CHANNELS * sizeof(short) );//a short device buffer; the mixer's ring is the real one
+
+	mixer->Update();//so the output doesn't start on an empty ring
+	pump = new QTimer(this);
+	connect(pump, SIGNAL(timeout()), this, SLOT(Pump()));
+	pump->start(MIX_PUMP);
+
+	open(QIODevice::ReadOnly);
+	output->start(this);
+	return output->error() == QAudio::NoError;
+}
+
+void MixerDevice::Pump()
+{
+	mixer->Update();
+}
+
+void MixerDevice::Stop()
+{
+	if( pump != NULL )
+	{
+		pump->stop();
+		delete pump;
+		pump = NULL;
+	}
+	if( output != NULL )
+	{
+		output->stop();
+		delete output;
+		output = NULL;
+	}
+	close();
+}
+
+//the output wants up to maxlen more bytes; it always gets whole frames, with
+//silence if the mixer has fallen behind
+qint64 MixerDevice::readData(char *data, qint64 maxlen)
+{
+	int frames = (int)(maxlen / (MIX_CHANNELS * sizeof(short)));
+	if( frames <= 0 )
+		return 0;
+
+	mixer->Read( (short*)data, frames );
+	return (qint64)frames * MIX_CHANNELS * sizeof(short);
+}
@@ -0,0 +1,44 @@
+//* mixerdevice.h *//
+
+#ifndef MIXERDEVICE_H
+#define MIXERDEVICE_H
+
+#include <QIODevice>
+
+class Mixer;
+class QAudioOutput;
+class QTimer;
+
+const int MIX_PUMP = 5;//ms between the mixer's Update()s
+
+//plays a Mixer (mixer.h) through the sound card: the audio output pulls its
+//buffers from here, on its own thread, and they come straight out of the
+//mixer's ring. Start() opens the default output at MIX_RATE, 16-bit stereo, and
+//from then on a timer keeps the ring topped up (whether the game is running or
+//not); that timer's thread is the mixing thread.
+class MixerDevice : public QIODevice
+{
+	Q_OBJECT
+
+private slots:
+	void Pump();
+
+protected:
+	qint64 readData(char *data, qint64 maxlen);
+	qint64 writeData(const char * /* data */, qint64 /* len */) { return -1; }
+
+public:
+
+	Mixer *mixer;
+	QAudioOutput *output;
+	QTimer *pump;
+
+	MixerDevice(Mixer *mixer_in, QObject *parent = 0);
+	~MixerDevice();
+
+	bool Start();
+	void Stop();
+
+};
+
+#endif //MIXERDEVICE_H
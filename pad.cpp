@@ -2,13 +2,14 @@
 #include <QKeyEvent>
 
 #include "pad.h"
+#include "levels.h"
 
 Pad::Pad(QWidget* parent)
 		: QWidget(parent)
 {
     //Constructor
     setPalette(QColor(255,255,255));
-    setFixedSize( 72, 5 );
+    setFixedSize( PAD_W, 5 );
     
     setFocus();
 }
@@ -31,13 +32,13 @@ void Pad::keyPressEvent(QKeyEvent *event)
 	switch( event->key() )
 	{
 		case Qt::Key_Left:
-			if( x() > 60 )
-				submove(x()-5, y());
+			if( x() > PAD_MINX + PAD_STEP )
+				submove(x()-PAD_STEP, y());
 			break;
 			
 		case Qt::Key_Right:
-			if( x() < 300 )
-				submove(x()+5, y());
+			if( x() < PAD_MAXX - PAD_STEP )
+				submove(x()+PAD_STEP, y());
 		    break;
 		    
 		default:
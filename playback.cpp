@@ -0,0 +1,123 @@
+//* playback.cpp *//
+
+//plays a ReplayLog (i.e the session.rpl the game writes on exit) headless, as
+//fast as it can, and prints where everything ended up. with -check it plays
+//the log twice and compares the state of the world after every tick, which
+//should always be identical.
+//
+//this doesn't need Qt; build it on its own with i.e
+//
+//	g++ -std=c++14 -O2 -pthread playback.cpp replaylog.cpp world.cpp jobsystem.cpp body.cpp bodyset.cpp broadphase.cpp tilegrid.cpp sparsetiles.cpp levelfile.cpp chunkstore.cpp -o playback
+//
+//and run it as "playback session.rpl [-check]".
+
+#include <cstdio>
+#include <cstring>
+#include <stdint.h>
+#include <vector>
+#include <string>
+#include <chrono>
+
+#include "tilegrid.h"
+#include "world.h"
+#include "replaylog.h"
+
+using namespace std;
+
+//FNV-1a over the bytes of everything that moves or changes in w
+static uint64_t Hash(World *w, uint64_t h)
+{
+	const BodySet &b = w->bodies;
+	const void *blocks[] = { b.x.empty() ? NULL : &b.x[0], b.y.empty() ? NULL : &b.y[0], b.ox.empty() ? NULL : &b.ox[0], b.oy.empty() ? NULL : &b.oy[0], w->tiles->id, w->tiles->hp };
+	const size_t sizes[] = { b.x.size()*sizeof(double), b.y.size()*sizeof(double), b.ox.size()*sizeof(double), b.oy.size()*sizeof(double), (size_t)w->tiles->Stored(), (size_t)w->tiles->Stored() };
+
+	for( int q = 0; q < 6; q++ )
+	{
+		const unsigned char *p = (const unsigned char*)blocks[q];
+		for( size_t n = 0; n < sizes[q]; n++ )
+		{
+			h ^= p[n];
+			h *= 1099511628211ull;
+		}
+	}
+	return h;
+}
+
+//plays the whole log; if hashes isn't NULL, the state after every tick is hashed into it
+static World* PlayAll(ReplayLog &log, vector< uint64_t > *hashes, long &ticks, double &ms)
+{
+	World *w = log.NewWorld();
+	ticks = 0;
+
+	chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+	if( hashes == NULL )
+	{
+		ticks = log.Play(w);
+	}
+	else
+	{
+		uint64_t h = 14695981039346656037ull;
+		while( !log.Done() )
+		{
+			ticks += log.Play(w, 1);
+			h = Hash(w, h);
+			hashes->push_back( h );
+		}
+	}
+	chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+
+	ms = chrono::duration<double, milli>(t1 - t0).count();
+	return w;
+}
+
+int main(int argc, char **argv)
+{
+	if( argc < 2 )
+	{
+		printf("usage: playback file.rpl [-check]\n");
+		return 1;
+	}
+	int check = (2 < argc && strcmp(argv[2], "-check") == 0);
+
+	ReplayLog log;
+	if( !log.Load(argv[1]) )
+	{
+		printf("can't read a replay from %s\n", argv[1]);
+		return 1;
+	}
+
+	long ticks;
+	double ms;
+	vector< uint64_t > first, second;
+
+	World *w = PlayAll(log, check ? &first : NULL, ticks, ms);
+	printf("%ld ticks in %.3f ms (%.0f ticks/s), log is %d bytes\n", ticks, ms, (ms > 0) ? ticks / ms * 1000 : 0.0, (int)log.data.size());
+
+	for( int k = 0; k < w->bodies.Count(); k++ )
+	{
+		printf("body %d: pos (%.17g, %.17g) oldpos (%.17g, %.17g)%s\n", k,
+			   w->bodies.x[k], w->bodies.y[k], w->bodies.ox[k], w->bodies.oy[k], w->bodies.IsDead(k) ? " dead" : "");
+	}
+	printf("tiles: %s\n", w->tiles->GetTileStates().c_str());
+	delete w;
+
+	if( check )
+	{
+		World *again = PlayAll(log, &second, ticks, ms);
+		delete again;
+
+		size_t bad = 0;
+		while( bad < first.size() && bad < second.size() && first[bad] == second[bad] )
+			bad++;
+
+		if( bad == first.size() && first.size() == second.size() )
+			printf("check: both playbacks identical over %d ticks\n", (int)first.size());
+		else
+		{
+			printf("check: playbacks differ from tick %d\n", (int)bad);
+			return 2;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,34 @@
+//* random.h *//
+
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <stdint.h>
+
+//a small seeded random number generator (xorshift32), used instead of rand()
+//for everything that affects the simulation. it only does integer math and
+//keeps its whole state in one member, so a given seed gives the same sequence
+//on every machine and a World can be replayed exactly (see ReplayLog).
+class Random
+{
+
+public:
+
+	uint32_t state;
+
+	Random(const uint32_t &seed = 1) { Seed(seed); }
+
+	inline void Seed(const uint32_t &seed) { state = (seed != 0) ? seed : 0x9E3779B9u; }//xorshift can't start from 0
+
+	//returns a number in [0, 2^31)
+	inline int Next()
+	{
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return (int)(state >> 1);
+	}
+
+};
+
+#endif //RANDOM_H
@@ -0,0 +1,389 @@
+//* replaylog.cpp *//
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <stdint.h>
+
+#include "tilegrid.h"
+#include "world.h"
+#include "replaylog.h"
+
+using namespace std;
+
+ReplayLog::ReplayLog()
+{
+	runpad[0] = runpad[1] = runpad[2] = 0;
+	runcount = 0;
+	cursor = 0;
+}
+
+//--------------------------------- recording ---------------------------------
+
+//starts a new log for w; w's tile grid should have been Build()'t already
+void ReplayLog::Begin(World *w)
+{
+	data.clear();
+	runcount = 0;
+	cursor = 0;
+
+	data.push_back('R');
+	data.push_back('P');
+	data.push_back('L');
+	data.push_back('Y');
+	Put8( REPLAY_VERSION );
+	Put16( w->tiles->rows );
+	Put16( w->tiles->cols );
+	Put16( w->tiles->xw );
+	Put16( w->tiles->yw );
+	Put8( w->swept );
+	Put8( w->fixed ? 1 : (w->single ? 2 : 0) );
+}
+
+void ReplayLog::Seed(const unsigned int &seed)
+{
+	Flush();
+	Put8( ROP_SEED );
+	Put32( seed );
+}
+
+void ReplayLog::AddBody(const Vector2 &pos_in, const int &r_in)
+{
+	Flush();
+	Put8( ROP_ADDBODY );
+	PutDouble( pos_in.x );
+	PutDouble( pos_in.y );
+	Put32( (unsigned int)r_in );
+}
+
+void ReplayLog::PlaceBody(const int &k, const Vector2 &pos_in, const Vector2 &oldpos_in)
+{
+	Flush();
+	Put8( ROP_PLACEBODY );
+	Put32( (unsigned int)k );
+	PutDouble( pos_in.x );
+	PutDouble( pos_in.y );
+	PutDouble( oldpos_in.x );
+	PutDouble( oldpos_in.y );
+}
+
+void ReplayLog::LoadLevel(const string &level)
+{
+	Flush();
+	Put8( ROP_LEVEL );
+	Put32( (unsigned int)level.size() );
+	data.insert( data.end(), level.begin(), level.end() );
+}
+
+//one step of the World, with the pad at (padx,pady) and padw wide; ticks with the
+//pad in the same place (most of them) are merged into a single record
+void ReplayLog::Tick(const int &padx, const int &pady, const int &padw)
+{
+	if( 0 < runcount && runcount < 0xFFFF && padx == runpad[0] && pady == runpad[1] && padw == runpad[2] )
+	{
+		runcount++;
+		return;
+	}
+
+	Flush();
+	runpad[0] = padx;
+	runpad[1] = pady;
+	runpad[2] = padw;
+	runcount = 1;
+}
+
+//writes out the pending run of ticks, if any
+void ReplayLog::Flush()
+{
+	if( runcount == 0 )
+		return;
+
+	Put8( ROP_TICKS );
+	Put16( runpad[0] );
+	Put16( runpad[1] );
+	Put16( runpad[2] );
+	Put16( runcount );
+	runcount = 0;
+}
+
+bool ReplayLog::Save(const string &filename)
+{
+	Flush();
+
+	if( data.empty() )
+		return false;
+
+	FILE *f = fopen(filename.c_str(), "wb");
+	if( f == NULL )
+		return false;
+
+	bool ok = ( fwrite(&data[0], 1, data.size(), f) == data.size() );
+	fclose(f);
+	return ok;
+}
+
+bool ReplayLog::Load(const string &filename)
+{
+	FILE *f = fopen(filename.c_str(), "rb");
+	if( f == NULL )
+		return false;
+
+	data.clear();
+	unsigned char buf[4096];
+	size_t n;
+	while( (n = fread(buf, 1, sizeof(buf), f)) > 0 )
+	{
+		data.insert( data.end(), buf, buf + n );
+	}
+	fclose(f);
+
+	runcount = 0;
+	cursor = 0;
+
+	if( data.size() < 5 || memcmp(&data[0], "RPLY", 4) != 0 )
+		return false;
+	return data[4] == REPLAY_VERSION && REPLAY_HEADER <= (int)data.size();
+}
+
+//--------------------------------- playback ----------------------------------
+
+//makes a World like the one the log was recorded from, ready for Play()
+World* ReplayLog::NewWorld()
+{
+	cursor = 5;//skip "RPLY" and the version
+	runcount = 0;
+
+	int rows = Get16();
+	int cols = Get16();
+	int xw = Get16();
+	int yw = Get16();
+
+	World *w = new World(rows, cols, xw, yw);
+	w->tiles->Build();
+	w->swept = Get8();
+	int precision = Get8();
+	w->fixed = (precision == 1);
+	w->single = (precision == 2);
+
+	return w;
+}
+
+//if level is something TileGrid::SetTileStates() can load into g: a tile ID for
+//every cell (it reads rows*cols of them), and nothing that isn't one
+static bool LevelFits(const TileGrid *g, const string &level)
+{
+	if( (int)level.size() < g->rows*g->cols )
+		return false;
+	for( size_t c = 0; c < level.size(); c++ )
+	{
+		int ID = (unsigned char)level[c] - CHAR_PAD;
+		if( ID < 0 || TID_COUNT <= ID )
+			return false;
+	}
+	return true;
+}
+
+//the most a coordinate or a radius in a log can be, either way. a World takes
+//a body anywhere (it dies once it's off the board), but it squares distances
+//and speeds on the way, and with World::fixed set that overflows not far past
+//this (see fixed.h)
+const double REPLAY_MAXCOORD = 1 << 14;
+
+//if v is a number a World can take from a log: finite, and not past REPLAY_MAXCOORD
+static bool Coordinate(const double &v)
+{
+	return fabs(v) < REPLAY_MAXCOORD;//(false for NaN, too)
+}
+
+//plays the log into w, which should come from NewWorld(), until maxticks steps
+//have been run (or to the end, if maxticks < 0); returns the number of steps run.
+//it can be called again to carry on from where it stopped.
+long ReplayLog::Play(World *w, const long &maxticks)
+{
+	long ticks = 0;
+
+	while( maxticks < 0 || ticks < maxticks )
+	{
+		if( 0 < runcount )
+		{
+			w->padx = runpad[0];
+			w->pady = runpad[1];
+			w->padw = runpad[2];
+			w->Step();
+			runcount--;
+			ticks++;
+			continue;
+		}
+
+		if( data.size() <= cursor )
+			break;
+
+		int op = Get8();
+		int size = RecordSize(op);
+		if( size < 0 || !Left(size) )
+		{
+			//"ReplayLog::Play() found an unknown or cut-off record; the log is damaged"
+			Damaged();
+			break;
+		}
+
+		if( op == ROP_SEED )
+		{
+			w->Seed( Get32() );
+		}
+		else if( op == ROP_ADDBODY )
+		{
+			double x = GetDouble();
+			double y = GetDouble();
+			int rad = (int)Get32();
+			if( !Coordinate(x) || !Coordinate(y) || rad < 0 || !Coordinate(rad) )
+			{
+				//"ReplayLog::Play() found a body with numbers a World can't take; the log is damaged"
+				Damaged();
+				break;
+			}
+			w->AddBody( Vector2(x, y), rad );
+		}
+		else if( op == ROP_PLACEBODY )
+		{
+			unsigned int k = Get32();
+			double x = GetDouble();
+			double y = GetDouble();
+			double ox = GetDouble();
+			double oy = GetDouble();
+			if( (unsigned int)w->bodies.Count() <= k )
+			{
+				//"ReplayLog::Play() found a body that was never added; the log is damaged"
+				Damaged();
+				break;
+			}
+			if( !Coordinate(x) || !Coordinate(y) || !Coordinate(ox) || !Coordinate(oy) )
+			{
+				//"ReplayLog::Play() found a body with numbers a World can't take; the log is damaged"
+				Damaged();
+				break;
+			}
+			w->PlaceBody( (int)k, Vector2(x, y), Vector2(ox, oy) );
+		}
+		else if( op == ROP_LEVEL )
+		{
+			unsigned int n = Get32();
+			if( !Left(n) )
+			{
+				//"ReplayLog::Play() found a level that runs off the end; the log is damaged"
+				Damaged();
+				break;
+			}
+			string level( data.begin() + cursor, data.begin() + cursor + n );
+			cursor += n;
+			if( !LevelFits(w->tiles, level) )
+			{
+				//"ReplayLog::Play() found a level that isn't one; the log is damaged"
+				Damaged();
+				break;
+			}
+			w->LoadLevel( level );
+		}
+		else if( op == ROP_TICKS )
+		{
+			runpad[0] = Get16();
+			runpad[1] = Get16();
+			runpad[2] = Get16();
+			runcount = Get16() & 0xFFFF;
+		}
+	}
+
+	return ticks;
+}
+
+//bytes that follow a record's op byte (a ROP_LEVEL's string not counted), or
+//-1 if op isn't a REPLAY_OP
+int ReplayLog::RecordSize(const int &op)
+{
+	switch( op )
+	{
+	case ROP_SEED: return 4;
+	case ROP_ADDBODY: return 8 + 8 + 4;
+	case ROP_PLACEBODY: return 4 + 4*8;
+	case ROP_LEVEL: return 4;
+	case ROP_TICKS: return 4*2;
+	default: return -1;
+	}
+}
+
+//if there are at least n bytes left to read
+bool ReplayLog::Left(const size_t &n) const
+{
+	return cursor <= data.size() && n <= data.size() - cursor;
+}
+
+//gives up on the rest of the log, so Play() stops and Done() is true
+void ReplayLog::Damaged()
+{
+	cursor = data.size();
+}
+
+bool ReplayLog::Done() const
+{
+	return runcount == 0 && data.size() <= cursor;
+}
+
+//------------------------------- byte coding ---------------------------------
+
+void ReplayLog::Put8(const int &v)
+{
+	data.push_back( (unsigned char)(v & 0xFF) );
+}
+
+void ReplayLog::Put16(const int &v)
+{
+	Put8( v );
+	Put8( v >> 8 );
+}
+
+void ReplayLog::Put32(const unsigned int &v)
+{
+	Put16( (int)(v & 0xFFFF) );
+	Put16( (int)(v >> 16) );
+}
+
+//doubles are stored as their bit pattern, so positions come back exactly
+void ReplayLog::PutDouble(const double &v)
+{
+	uint64_t bits;
+	memcpy(&bits, &v, sizeof(bits));
+	Put32( (unsigned int)(bits & 0xFFFFFFFFu) );
+	Put32( (unsigned int)(bits >> 32) );
+}
+
+int ReplayLog::Get8()
+{
+	if( data.size() <= cursor )
+		return 0;
+	return data[cursor++];
+}
+
+//signed, since pad coordinates can be
+int ReplayLog::Get16()
+{
+	int lo = Get8();
+	int hi = Get8();
+	return (int16_t)(lo | (hi << 8));
+}
+
+unsigned int ReplayLog::Get32()
+{
+	unsigned int lo = Get16() & 0xFFFF;
+	unsigned int hi = Get16() & 0xFFFF;
+	return lo | (hi << 16);
+}
+
+double ReplayLog::GetDouble()
+{
+	uint64_t lo = Get32();
+	uint64_t hi = Get32();
+	uint64_t bits = lo | (hi << 32);
+	double v;
+	memcpy(&v, &bits, sizeof(v));
+	return v;
+}
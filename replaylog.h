@@ -0,0 +1,101 @@
+//* replaylog.h *//
+
+#ifndef REPLAYLOG_H
+#define REPLAYLOG_H
+
+#include <vector>
+#include <string>
+
+#include "vector2.h"
+
+class World;
+
+//everything that goes into a World from outside, in order, as a compact binary
+//log: the random seed, bodies being added or placed, levels being loaded, and
+//the pad for every tick. since the simulation itself is deterministic, playing
+//the log into a fresh World reproduces the session bit for bit, and without Qt
+//or a timer it runs as fast as the CPU allows.
+//
+//bit for bit on the same build, that is; a log recorded with World::fixed set
+//plays out the same on any compiler and CPU, with any number of balls.
+//
+//a World records into a ReplayLog when its recorder is set; see World.
+//
+//layout (all numbers little-endian):
+//	header: "RPLY", u8 version, u16 rows, cols, xw, yw, u8 swept, precision
+//	        (0 double, 1 World::fixed, 2 World::single)
+//	        (logs from before version 3 were recorded when a collision hit its
+//	        tile as soon as it was found, not at the end of the step (see
+//	        World::ApplyCollisions()), and version 3 ones when the balls were
+//	        pushed apart cell by cell, not band by band (see Broadphase); they'd
+//	        play out differently now, so they aren't read)
+//	records, each starting with a REPLAY_OP byte:
+//	  ROP_SEED      u32 seed
+//	  ROP_ADDBODY   f64 x, y, i32 r
+//	  ROP_PLACEBODY u32 body, f64 x, y, oldx, oldy
+//	  ROP_LEVEL     u32 length, then the tile string (see TileGrid::GetTileStates())
+//	  ROP_TICKS     i16 padx, pady, padw, u16 count; count ticks with the pad there
+
+enum REPLAY_OP {
+	ROP_SEED = 'S',
+	ROP_ADDBODY = 'A',
+	ROP_PLACEBODY = 'P',
+	ROP_LEVEL = 'L',
+	ROP_TICKS = 'T'
+};
+
+const int REPLAY_VERSION = 4;
+const int REPLAY_HEADER = 15;//bytes
+
+class ReplayLog
+{
+
+public:
+
+	std::vector< unsigned char > data;
+
+	ReplayLog();
+	~ReplayLog() { }
+
+	//recording
+	void Begin(World *w);
+	void Seed(const unsigned int &seed);
+	void AddBody(const Vector2 &pos_in, const int &r_in);
+	void PlaceBody(const int &k, const Vector2 &pos_in, const Vector2 &oldpos_in);
+	void LoadLevel(const std::string &level);
+	void Tick(const int &padx, const int &pady, const int &padw);
+	void Flush();
+
+	bool Save(const std::string &filename);
+	bool Load(const std::string &filename);
+
+	//playback
+	World* NewWorld();
+	long Play(World *w, const long &maxticks = -1);
+	bool Done() const;
+
+private:
+
+	//the run of identical ticks being recorded, or played back
+	int runpad[3];
+	int runcount;
+
+	size_t cursor;//read position in data
+
+	void Put8(const int &v);
+	void Put16(const int &v);
+	void Put32(const unsigned int &v);
+	void PutDouble(const double &v);
+
+	int Get8();
+	int Get16();
+	unsigned int Get32();
+	double GetDouble();
+
+	static int RecordSize(const int &op);
+	bool Left(const size_t &n) const;
+	void Damaged();
+
+};
+
+#endif //REPLAYLOG_H
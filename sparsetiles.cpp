@@ -0,0 +1,134 @@
+//* sparsetiles.cpp *//
+
+#include <vector>
+#include <stdint.h>
+
+#include "tilegrid.h"
+#include "sparsetiles.h"
+
+using namespace std;
+
+const int SPARSE_MINTABLE = 64;//entries
+
+SparseTiles::SparseTiles()
+{
+	Clear();
+}
+
+//forgets every cell; only the sentinel is left
+void SparseTiles::Clear()
+{
+	table.assign(SPARSE_MINTABLE, 0);
+	mask = SPARSE_MINTABLE - 1;
+
+	keys.assign(1, SPARSE_NOKEY);//the sentinel has no cell
+	id.assign(1, TID_EMPTY);
+	ctype.assign(1, CTYPE_EMPTY);
+	edges.assign(1, 0);
+	signs.assign(1, (0+1) | ((0+1) << 2));
+	hp.assign(1, 0);
+	mat.assign(1, 0);
+
+	spare.clear();
+	used = 0;
+}
+
+//returns the slot of cell (i,j), giving it a new one (as empty space) if it had
+//none. the planes may move in memory, but no slot changes its index.
+int SparseTiles::Insert(const int &i, const int &j)
+{
+	uint64_t key = Key(i, j);
+	uint32_t e = Hash(key) & mask;
+	for( ; table[e] != 0; e = (e + 1) & mask )
+	{
+		if( keys[ table[e] ] == key )
+			return table[e];
+	}
+
+	int k;
+	if( !spare.empty() )
+	{
+		k = spare.back();
+		spare.pop_back();
+		keys[k] = key;
+		id[k] = id[0];
+		ctype[k] = ctype[0];
+		edges[k] = edges[0];
+		signs[k] = signs[0];
+		hp[k] = hp[0];
+		mat[k] = mat[0];
+	}
+	else
+	{
+		k = (int)keys.size();
+		keys.push_back(key);
+		id.push_back(id[0]);
+		ctype.push_back(ctype[0]);
+		edges.push_back(edges[0]);
+		signs.push_back(signs[0]);
+		hp.push_back(hp[0]);
+		mat.push_back(mat[0]);
+	}
+
+	table[e] = k;
+	used++;
+	if( (int)table.size() < 2*used )//keep the table at most half full
+		Grow();
+	return k;
+}
+
+//lets go of slot k. the entries after it in its run are shifted back into the
+//gap, so lookups never need tombstones.
+void SparseTiles::Remove(const int &k)
+{
+	if( k == 0 )
+		return;
+
+	uint32_t e = Hash(keys[k]) & mask;
+	while( (int)table[e] != k )
+		e = (e + 1) & mask;
+
+	uint32_t gap = e;
+	for( e = (e + 1) & mask; table[e] != 0; e = (e + 1) & mask )
+	{
+		uint32_t home = Hash( keys[ table[e] ] ) & mask;
+		//the entry can move into the gap if its home isn't between the gap and where it is now
+		if( ((e - home) & mask) >= ((e - gap) & mask) )
+		{
+			table[gap] = table[e];
+			gap = e;
+		}
+	}
+	table[gap] = 0;
+
+	keys[k] = SPARSE_NOKEY;
+	id[k] = TID_EMPTY;
+	edges[k] = 0;
+	spare.push_back(k);
+	used--;
+}
+
+//memory held for the cells, in bytes
+size_t SparseTiles::Bytes() const
+{
+	return table.capacity()*sizeof(uint32_t) + keys.capacity()*sizeof(uint64_t) + spare.capacity()*sizeof(int) +
+		   id.capacity() + ctype.capacity() + edges.capacity() + signs.capacity() + hp.capacity() + mat.capacity();
+}
+
+//doubles the table, and puts every slot back into it
+void SparseTiles::Grow()
+{
+	table.assign(2*table.size(), 0);
+	mask = (int)table.size() - 1;
+
+	for( int k = 1; k < (int)keys.size(); k++ )
+	{
+		if( IsSpare(k) )
+			continue;
+
+		uint32_t e = Hash(keys[k]) & mask;
+		while( table[e] != 0 )
+			e = (e + 1) & mask;
+		table[e] = k;
+	}
+}
@@ -0,0 +1,79 @@
+//* sparsetiles.h *//
+
+#ifndef SPARSETILES_H
+#define SPARSETILES_H
+
+#include <vector>
+#include <cstddef>
+#include <stdint.h>
+
+const uint64_t SPARSE_NOKEY = ~(uint64_t)0;//key of the sentinel and of spare slots
+
+//the cells of a mostly-empty TileGrid (see TileGrid::BuildSparse()).
+//
+//only the cells that aren't plain empty space are kept: tiles, and the empty
+//cells next to them whose edges aren't all off. each one gets a slot, and the
+//slots hold the same 6 planes as a dense grid (id, ctype, edges, signs, hp,
+//mat), so a TileRef reads them exactly the same way. slot 0 is the sentinel: an
+//empty cell with every edge off, which stands in for every cell that isn't kept.
+//
+//slots are found through an open-addressing hash (linear probing) keyed by the
+//cell's packed (i,j). a slot stays where it is until its cell is removed, so its
+//index can be held on to like a dense one; only the table is rebuilt when it grows.
+class SparseTiles
+{
+
+public:
+
+	std::vector< uint32_t > table;//slot of each entry, 0 if the entry is free
+	int mask;//table.size()-1; the size is a power of 2
+
+	std::vector< uint64_t > keys;//Key(i,j) of each slot's cell
+	std::vector< unsigned char > id;
+	std::vector< unsigned char > ctype;
+	std::vector< unsigned char > edges;
+	std::vector< unsigned char > signs;
+	std::vector< unsigned char > hp;
+	std::vector< unsigned char > mat;
+
+	std::vector< int > spare;//slots that were removed, to be used again
+	int used;//slots in use, the sentinel not included
+
+	SparseTiles();
+	~SparseTiles() { }
+
+	void Clear();
+
+	static inline uint64_t Key(const int &i, const int &j) { return ((uint64_t)(uint32_t)j << 32) | (uint32_t)i; }
+	inline int I(const int &k) const { return (int)(uint32_t)keys[k]; }
+	inline int J(const int &k) const { return (int)(uint32_t)(keys[k] >> 32); }
+
+	inline int Slots() const { return (int)keys.size(); }//including the sentinel and spare slots
+	inline int IsSpare(const int &k) const { return keys[k] == SPARSE_NOKEY; }
+
+	//returns the slot of cell (i,j), or 0 (the sentinel) if it isn't kept
+	inline int Find(const int &i, const int &j) const
+	{
+		uint64_t key = Key(i, j);
+		for( uint32_t e = Hash(key) & mask; ; e = (e + 1) & mask )
+		{
+			uint32_t k = table[e];
+			if( k == 0 || keys[k] == key )
+				return k;
+		}
+	}
+
+	int Insert(const int &i, const int &j);
+	void Remove(const int &k);
+
+	size_t Bytes() const;
+
+private:
+
+	static inline uint32_t Hash(const uint64_t &key) { return (uint32_t)((key * 0x9E3779B97F4A7C15ull) >> 32); }
+
+	void Grow();
+
+};
+
+#endif //SPARSETILES_H
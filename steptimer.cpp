@@ -0,0 +1,73 @@
+//* steptimer.cpp *//
+
+#include "steptimer.h"
+
+using namespace std;
+
+StepTimer::StepTimer(const double &rate_in, const int &maxsteps_in)
+{
+	rate = rate_in;
+	maxsteps = maxsteps_in;
+	Start();
+}
+
+//forgets the backlog and the stats; call this whenever the loop (re)starts,
+//so the time spent paused isn't simulated all at once
+void StepTimer::Start()
+{
+	last = window = Clock::now();
+	acc = 0;
+
+	wframes = wsteps = 0;
+
+	stats.fps = 0;
+	stats.sps = 0;
+	stats.frames = 0;
+	stats.steps = 0;
+	stats.dropped = 0;
+	stats.caughtup = 0;
+	stats.laststeps = 0;
+}
+
+//call once per frame; returns how many physics steps to run before drawing it
+int StepTimer::Frame()
+{
+	Clock::time_point now = Clock::now();
+	acc += chrono::duration<double>(now - last).count();
+	last = now;
+
+	int n = (int)(acc * rate);
+	acc -= n / rate;
+
+	if( maxsteps < n )
+	{
+		stats.dropped += n - maxsteps;
+		n = maxsteps;
+	}
+	if( 1 < n )
+		stats.caughtup++;
+
+	stats.frames++;
+	stats.steps += n;
+	stats.laststeps = n;
+
+	//update the rates about once a second
+	wframes++;
+	wsteps += n;
+	double secs = chrono::duration<double>(now - window).count();
+	if( 1.0 <= secs )
+	{
+		stats.fps = wframes / secs;
+		stats.sps = wsteps / secs;
+		wframes = wsteps = 0;
+		window = now;
+	}
+
+	return n;
+}
+
+//how far we are into the next step, in [0,1); i.e for interpolating what's drawn
+double StepTimer::Alpha() const
+{
+	return acc * rate;
+}
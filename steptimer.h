@@ -0,0 +1,60 @@
+//* steptimer.h *//
+
+#ifndef STEPTIMER_H
+#define STEPTIMER_H
+
+#include <chrono>
+
+//what the StepTimer has been up to; the rates are measured over the last second or so
+struct StepStats
+{
+	double fps;//frames (calls to Frame()) per second
+	double sps;//physics steps per second
+
+	long frames;//totals since Start()
+	long steps;
+	long dropped;//steps skipped because we fell more than maxsteps behind
+	long caughtup;//frames that had to run more than one step
+
+	int laststeps;//steps run by the last frame
+};
+
+//a fixed-timestep accumulator: the physics always advances in steps of
+//1/rate seconds, however often (or unevenly) frames are drawn. each frame adds
+//the real time since the last one, read from a monotonic clock, and asks for
+//as many whole steps as fit in it; the rest carries over to the next frame.
+//
+//if a frame comes very late (the window was dragged, the machine is loaded..)
+//at most maxsteps are run and the rest of the backlog is dropped, so that
+//catching up can't take longer than the time it's catching up on.
+class StepTimer
+{
+
+public:
+
+	typedef std::chrono::steady_clock Clock;
+
+	double rate;//physics steps per second
+	int maxsteps;//most steps run by one frame
+
+	StepStats stats;
+
+	StepTimer(const double &rate_in = 100, const int &maxsteps_in = 5);
+	~StepTimer() { }
+
+	void Start();
+	int Frame();
+	double Alpha() const;
+
+private:
+
+	Clock::time_point last;//time of the last frame
+	Clock::time_point window;//start of the current stats window
+	double acc;//seconds not yet simulated
+
+	long wframes;//frames and steps in the current stats window
+	long wsteps;
+
+};
+
+#endif //STEPTIMER_H
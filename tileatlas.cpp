@@ -0,0 +1,101 @@
+//* tileatlas.cpp *//
+
+#include <cstdio>
+#include <string>
+#include <QImage>
+#include <QPainter>
+
+#include "tilegrid.h"
+#include "tilemapcell.h"
+#include "tileatlas.h"
+
+using namespace std;
+
+//first row of each color_t, and how many HP (rows) it has
+static const int LOOK_BASE[3] = { 1, 3, 7 };
+static const int LOOK_HP[3] = { 2, 4, 8 };
+
+TileAtlas::TileAtlas()
+{
+	xw = yw = 0;
+	tw = th = 0;
+}
+
+//makes sure the atlas is drawn for tiles of halfwidths xw_in/yw_in, loading it
+//from its cache file if there is one, or else drawing it and saving that.
+//returns true if the atlas changed (so whatever was drawn from it is stale).
+bool TileAtlas::Fit(const int &xw_in, const int &yw_in)
+{
+	if( !image.isNull() && xw == xw_in && yw == yw_in )
+		return false;
+	
+	xw = xw_in;
+	yw = yw_in;
+	tw = 2*xw;
+	th = 2*yw;
+	
+	string filename = Filename();
+	if( image.load( QString::fromStdString(filename) ) && image.width() == TID_COUNT*tw && image.height() == ATLAS_LOOKS*th )
+	{
+		image = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+		return true;
+	}
+	
+	Make();
+	image.save( QString::fromStdString(filename), "PNG" );//if it can't be saved, it's made again next time
+	return true;
+}
+
+//the row of a tile with the given color_t and HP
+int TileAtlas::Look(const int &color_t, const int &HP, const int &unbreakable)
+{
+	if( unbreakable )
+		return 0;
+	
+	int c = (color_t < 3) ? color_t : 0;
+	int hp = HP;
+	if( hp < 1 ) hp = 1;
+	if( LOOK_HP[c] < hp ) hp = LOOK_HP[c];
+	return LOOK_BASE[c] + hp - 1;
+}
+
+//where tile t's sprite is
+QRect TileAtlas::Sprite(const TileRef &t) const
+{
+	return Sprite( t.ID(), Look(t.color_t(), t.HP(), t.unbreakable()) );
+}
+
+//the cache file for the current tile size
+string TileAtlas::Filename() const
+{
+	char name[64];
+	snprintf(name, sizeof(name), "tileatlas-v%d-%dx%d.png", ATLAS_VERSION, xw, yw);
+	return name;
+}
+
+//draws every shape in every look; column TID_EMPTY stays clear
+void TileAtlas::Make()
+{
+	image = QImage(TID_COUNT*tw, ATLAS_LOOKS*th, QImage::Format_ARGB32_Premultiplied);
+	image.fill(0);
+	
+	QPainter painter(&image);
+	painter.setRenderHint(QPainter::Antialiasing, 1);
+	
+	for( int look = 0; look < ATLAS_LOOKS; look++ )
+	{
+		int c = 0;
+		while( c < 2 && LOOK_BASE[c+1] <= look )
+			c++;
+		painter.setBrush( TileBrush(c, look - LOOK_BASE[c] + 1, look == 0) );
+		
+		for( int ID = 1; ID < TID_COUNT; ID++ )
+		{
+			QRect r = Sprite(ID, look);
+			painter.setClipRect(r);
+			painter.translate(r.x(), r.y());
+			PaintTile(painter, ID, xw, yw);
+			painter.translate(-r.x(), -r.y());
+		}
+	}
+}
@@ -0,0 +1,50 @@
+//* tileatlas.h *//
+
+#ifndef TILEATLAS_H
+#define TILEATLAS_H
+
+#include <QImage>
+#include <QRect>
+#include <string>
+
+class TileRef;
+
+const int ATLAS_VERSION = 1;//bump this when the tiles are drawn differently, so cached atlases get made again
+const int ATLAS_LOOKS = 1 + 2 + 4 + 8;//unbreakable gray, then every HP of color_t 0, 1 and 2
+
+//every tile shape (TID_*), in every look a tile can have, prebaked at one tile
+//size; drawing a tile is then a single blit from here (see TileMap).
+//
+//there's a column per ID and a row per look: row 0 is the unbreakable gray,
+//then each color_t has a row per HP it can have (its alpha goes with the HP).
+//the atlas is drawn once (see PaintTile()) and cached to disk next to the game,
+//one file per tile size; Fit() makes or loads it again whenever the size changes.
+class TileAtlas
+{
+
+public:
+
+	QImage image;
+	int xw;//tile halfwidths the atlas was drawn for; 0 before the first Fit()
+	int yw;
+	int tw;
+	int th;
+
+	TileAtlas();
+	~TileAtlas() { }
+
+	bool Fit(const int &xw_in, const int &yw_in);
+
+	static int Look(const int &color_t, const int &HP, const int &unbreakable);
+	inline QRect Sprite(const int &ID, const int &look) const { return QRect(ID*tw, look*th, tw, th); }
+	QRect Sprite(const TileRef &t) const;
+
+	std::string Filename() const;
+
+private:
+
+	void Make();
+
+};
+
+#endif //TILEATLAS_H
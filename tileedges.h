@@ -0,0 +1,109 @@
+//* tileedges.h *//
+
+#ifndef TILEEDGES_H
+#define TILEEDGES_H
+
+#include "tilegrid.h"
+
+//the state of an edge between a cell and its neighbor depends only on the two
+//tile IDs and on which side of the cell the neighbor is on. so instead of
+//re-running the rules every time an edge is updated, they are evaluated at
+//compile time for every pair of IDs into EDGE_TABLE:
+//
+//	EDGE_TABLE.e[ID][nID] holds, packed like TileGrid::edges (see EDGE_SHIFT),
+//	the state of each side of a cell with ID, if nID were the neighbor on that side.
+//
+//so the up-edge of a cell is (EDGE_TABLE.e[ID][ID of the cell above] >> ESHIFT_U) & 3, etc.
+
+
+//the sign of the tile normal, per ID; this mirrors TileShapes() but has to be
+//known at compile time. IDs 2..29 come in groups of 4 ordered pn,nn,np,pp
+constexpr int EdgeSignX(const int &ID)
+{
+	return (ID < TID_45DEGpn) ? 0 :
+		(ID < TID_HALFd) ? ( (((ID - TID_45DEGpn) % 4) == 1 || ((ID - TID_45DEGpn) % 4) == 2) ? -1 : 1 ) :
+		(ID == TID_HALFr) ? -1 :
+		(ID == TID_HALFl) ? 1 : 0;
+}
+
+constexpr int EdgeSignY(const int &ID)
+{
+	return (ID < TID_45DEGpn) ? 0 :
+		(ID < TID_HALFd) ? ( (((ID - TID_45DEGpn) % 4) < 2) ? -1 : 1 ) :
+		(ID == TID_HALFd) ? -1 :
+		(ID == TID_HALFu) ? 1 : 0;
+}
+
+//these are the rules that used to be spelled out in TileCell::UpdateEdges().
+//
+//a side is seen from the cell: dir is -1 for up/left and 1 for down/right, vertical
+//says whether we're looking up/down (signy) or left/right (signx).
+//sS1/sS2 are the "small" 22/67 tiles that poke out towards the neighbor even though
+//their normal points away, nS1/nS2 are the ones that poke out of the neighbor towards us.
+
+//neighbor's surface points towards us; note that the <= is supposed to flag edges
+//sharesd with half-fulls as interesting, but it might also have unwanted negative sideeffects
+constexpr int EdgeTowards(const int &nID, const int &dir, const int &vertical, const int &nS1, const int &nS2)
+{
+	return ( (((vertical ? EdgeSignY(nID) : EdgeSignX(nID)) * dir) <= 0) || nID == nS1 || nID == nS2 );
+}
+
+//"open" sides (this cell is empty, or its normal points at the neighbor) can be off, interesting or solid
+constexpr int EdgeOpen(const int &nID, const int &dir, const int &vertical, const int &nS1, const int &nS2)
+{
+	return (nID == TID_EMPTY) ? EID_OFF :
+		(nID == TID_FULL) ? EID_SOLID :
+		EdgeTowards(nID, dir, vertical, nS1, nS2) ? EID_INTERESTING : EID_SOLID;
+}
+
+//"closed" sides (full cells, or sides the normal faces away from) are off or interesting
+constexpr int EdgeClosed(const int &nID, const int &dir, const int &vertical, const int &nS1, const int &nS2)
+{
+	return (nID == TID_FULL || nID == TID_EMPTY) ? EID_OFF :
+		EdgeTowards(nID, dir, vertical, nS1, nS2) ? EID_INTERESTING : EID_OFF;
+}
+
+constexpr int EdgeState(const int &ID, const int &nID, const int &dir, const int &vertical, const int &sS1, const int &sS2, const int &nS1, const int &nS2)
+{
+	return (ID == TID_EMPTY) ? EdgeOpen(nID, dir, vertical, nS1, nS2) :
+		(ID == TID_FULL) ? EdgeClosed(nID, dir, vertical, nS1, nS2) :
+		(0 <= ((vertical ? EdgeSignY(ID) : EdgeSignX(ID)) * dir)) ? EdgeOpen(nID, dir, vertical, nS1, nS2) :
+		(ID == sS1 || ID == sS2) ? EdgeOpen(nID, dir, vertical, nS1, nS2) ://the small 22/67s are solid even on their back sides
+		EdgeClosed(nID, dir, vertical, nS1, nS2);
+}
+
+constexpr int EdgeStateU(const int &ID, const int &nID) { return EdgeState(ID, nID, -1, 1, TID_67DEGppS, TID_67DEGnpS, TID_67DEGpnS, TID_67DEGnnS); }
+constexpr int EdgeStateD(const int &ID, const int &nID) { return EdgeState(ID, nID,  1, 1, TID_67DEGpnS, TID_67DEGnnS, TID_67DEGppS, TID_67DEGnpS); }
+constexpr int EdgeStateL(const int &ID, const int &nID) { return EdgeState(ID, nID, -1, 0, TID_22DEGpnS, TID_22DEGppS, TID_22DEGnnS, TID_22DEGnpS); }
+constexpr int EdgeStateR(const int &ID, const int &nID) { return EdgeState(ID, nID,  1, 0, TID_22DEGnnS, TID_22DEGnpS, TID_22DEGpnS, TID_22DEGppS); }
+
+
+class EdgeTable
+{
+public:
+	unsigned char e[TID_COUNT][TID_COUNT];
+
+	constexpr EdgeTable() : e()
+	{
+		for( int ID = 0; ID < TID_COUNT; ID++ )
+		{
+			for( int nID = 0; nID < TID_COUNT; nID++ )
+			{
+				e[ID][nID] = (EdgeStateU(ID, nID) << ESHIFT_U) |
+							 (EdgeStateD(ID, nID) << ESHIFT_D) |
+							 (EdgeStateL(ID, nID) << ESHIFT_L) |
+							 (EdgeStateR(ID, nID) << ESHIFT_R);
+			}
+		}
+	}
+};
+
+constexpr EdgeTable EDGE_TABLE;
+
+//the state of one side of a cell; shift is one of EDGE_SHIFT
+inline int EdgeLookup(const int &ID, const int &nID, const int &shift)
+{
+	return (EDGE_TABLE.e[ID][nID] >> shift) & 3;
+}
+
+#endif //TILEEDGES_H
@@ -0,0 +1,1047 @@
+//* tilegrid.cpp *//
+
+/*
+this object manages a grid of static AABB tiles.
+*/
+
+//NOTE: the tilemap is now transparently padded; it is 2 rows and columns larger than
+//any other module knows; the extra rows/cols are a solid border.
+//
+//however, all client calls can remain the same since the tilemap handles the changes..
+//
+//this is the headless part of what used to be TileMap/TileMapCell; the widgets of
+//the same names now only draw what's in here.
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <string>
+
+#include "body.h"
+#include "vector2.h"
+#include "worldlistener.h"
+#include "tilegrid.h"
+#include "tileedges.h"
+#include "levelfile.h"
+
+using namespace std;
+
+
+//this converts a tile from implicitly-defined (via ID), to explicit (via properties);
+//it's only run once per tile ID, to fill the TileShapes() table
+static void ComputeShape(const int &ID, TileShape &shape)
+{
+	int &CTYPE = shape.CTYPE;
+	int &signx = shape.signx;
+	int &signy = shape.signy;
+	double &sx = shape.sx;
+	double &sy = shape.sy;
+	
+	CTYPE = CTYPE_EMPTY;
+	signx = 0;
+	signy = 0;
+	sx = 0;
+	sy = 0;
+	
+	if(0 < ID)
+	{
+		//tile is non-empty; collide
+		if(ID < CTYPE_45DEG)
+		{
+			//TID_FULL
+			CTYPE = CTYPE_FULL;
+			signx = 0;
+			signy = 0;
+			sx = 0;
+			sy = 0;
+		}
+		else if(ID < CTYPE_CONCAVE)
+		{
+
+			//45deg
+			CTYPE = CTYPE_45DEG;
+			if(ID == TID_45DEGpn)
+			{
+				signx = 1;
+				signy = -1;
+				sx = signx / SQRT2;//get slope _unit_ normal
+				sy = signy / SQRT2;//since normal is (1,-1), length is sqrt(1*1 + -1*-1) = sqrt(2)				
+			}
+			else if(ID == TID_45DEGnn)
+			{
+				signx = -1;
+				signy = -1;
+				sx = signx / SQRT2;//get slope _unit_ normal
+				sy = signy / SQRT2;//since normal is (1,-1), length is sqrt(1*1 + -1*-1) = sqrt(2)				
+			}
+			else if(ID == TID_45DEGnp)
+			{
+				signx = -1;
+				signy = 1;
+				sx = signx / SQRT2;//get slope _unit_ normal
+				sy = signy / SQRT2;//since normal is (1,-1), length is sqrt(1*1 + -1*-1) = sqrt(2)				
+			}
+			else if(ID == TID_45DEGpp)
+			{
+				signx = 1;
+				signy = 1;
+				sx = signx / SQRT2;//get slope _unit_ normal
+				sy = signy / SQRT2;//since normal is (1,-1), length is sqrt(1*1 + -1*-1) = sqrt(2)				
+			}				
+			else
+			{
+				return;
+			}				
+		}
+		else if(ID < CTYPE_CONVEX)
+		{
+
+			//concave
+			CTYPE = CTYPE_CONCAVE;
+			if(ID == TID_CONCAVEpn)
+			{
+				signx = 1;
+				signy = -1;
+				sx = 0;
+				sy = 0;
+			}
+			else if(ID == TID_CONCAVEnn)
+			{
+				signx = -1;
+				signy = -1;
+				sx = 0;
+				sy = 0;
+			}
+			else if(ID == TID_CONCAVEnp)
+			{
+				signx = -1;
+				signy = 1;
+				sx = 0;
+				sy = 0;
+			}	
+			else if(ID == TID_CONCAVEpp)
+			{
+				signx = 1;
+				signy = 1;
+				sx = 0;
+				sy = 0;
+			}
+			else
+			{
+				return;
+			}
+		}
+		else if(ID < CTYPE_22DEGs)
+		{
+					
+			//convex
+			CTYPE = CTYPE_CONVEX;
+			if(ID == TID_CONVEXpn)
+			{
+				signx = 1;
+				signy = -1;
+				sx = 0;
+				sy = 0;
+			}
+			else if(ID == TID_CONVEXnn)
+			{
+				signx = -1;
+				signy = -1;
+				sx = 0;
+				sy = 0;
+			}
+			else if(ID == TID_CONVEXnp)
+			{
+				signx = -1;
+				signy = 1;
+				sx = 0;
+				sy = 0;
+			}
+			else if(ID == TID_CONVEXpp)
+			{
+				signx = 1;
+				signy = 1;
+				sx = 0;
+				sy = 0;
+			}
+			else
+			{
+				return;
+			}
+		}
+		else if(ID < CTYPE_22DEGb)
+		{
+											
+			//22deg small
+			CTYPE = CTYPE_22DEGs;
+			if(ID == TID_22DEGpnS)
+			{
+				signx = 1;
+				signy = -1;
+				double slen = sqrt(2*2 + 1*1);
+				sx = (signx*1) / slen;
+				sy = (signy*2) / slen;				
+			}
+			else if(ID == TID_22DEGnnS)
+			{
+				signx = -1;
+				signy = -1;
+				double slen = sqrt(2*2 + 1*1);
+				sx = (signx*1) / slen;
+				sy = (signy*2) / slen;
+			}	
+			else if(ID == TID_22DEGnpS)
+			{
+				signx = -1;
+				signy = 1;
+				double slen = sqrt(2*2 + 1*1);
+				sx = (signx*1) / slen;
+				sy = (signy*2) / slen;
+			}
+			else if(ID == TID_22DEGppS)
+			{
+				signx = 1;
+				signy = 1;
+				double slen = sqrt(2*2 + 1*1);
+				sx = (signx*1) / slen;
+				sy = (signy*2) / slen;
+			}
+			else
+			{
+				return;
+			}							
+		}
+		else if(ID < CTYPE_67DEGs)
+		{
+														
+			//22deg big
+			CTYPE = CTYPE_22DEGb;
+			if(ID == TID_22DEGpnB)
+			{
+				signx = 1;
+				signy = -1;
+				double slen = sqrt(2*2 + 1*1);
+				sx = (signx*1) / slen;
+				sy = (signy*2) / slen;	
+			}
+			else if(ID == TID_22DEGnnB)
+			{
+				signx = -1;
+				signy = -1;
+				double slen = sqrt(2*2 + 1*1);
+				sx = (signx*1) / slen;
+				sy = (signy*2) / slen;	
+			}
+			else if(ID == TID_22DEGnpB)
+			{
+				signx = -1;
+				signy = 1;
+				double slen = sqrt(2*2 + 1*1);
+				sx = (signx*1) / slen;
+				sy = (signy*2) / slen;	
+			}
+			else if(ID == TID_22DEGppB)
+			{
+				signx = 1;
+				signy = 1;
+				double slen = sqrt(2*2 + 1*1);
+				sx = (signx*1) / slen;
+				sy = (signy*2) / slen;	
+			}
+			else
+			{
+				return;
+			}								
+		}
+		else if(ID < CTYPE_67DEGb)
+		{
+															
+			//67deg small
+			CTYPE = CTYPE_67DEGs;
+			if(ID == TID_67DEGpnS)
+			{
+				signx = 1;
+				signy = -1;
+				double slen = sqrt(2*2 + 1*1);
+				sx = (signx*2) / slen;
+				sy = (signy*1) / slen;	
+			}
+			else if(ID == TID_67DEGnnS)
+			{
+				signx = -1;
+				signy = -1;
+				double slen = sqrt(2*2 + 1*1);
+				sx = (signx*2) / slen;
+				sy = (signy*1) / slen;
+			}
+			else if(ID == TID_67DEGnpS)
+			{
+				signx = -1;
+				signy = 1;
+				double slen = sqrt(2*2 + 1*1);
+				sx = (signx*2) / slen;
+				sy = (signy*1) / slen;
+			}	
+			else if(ID == TID_67DEGppS)
+			{
+				signx = 1;
+				signy = 1;
+				double slen = sqrt(2*2 + 1*1);
+				sx = (signx*2) / slen;
+				sy = (signy*1) / slen;
+			}
+			else
+			{
+				return;
+			}									
+		}
+		else if(ID < CTYPE_HALF)
+		{
+								
+			//67deg big
+			CTYPE = CTYPE_67DEGb;
+			if(ID == TID_67DEGpnB)
+			{
+				signx = 1;
+				signy = -1;
+				double slen = sqrt(2*2 + 1*1);
+				sx = (signx*2) / slen;
+				sy = (signy*1) / slen;
+			}
+			else if(ID == TID_67DEGnnB)
+			{
+				signx = -1;
+				signy = -1;
+				double slen = sqrt(2*2 + 1*1);
+				sx = (signx*2) / slen;
+				sy = (signy*1) / slen;
+			}
+			else if(ID == TID_67DEGnpB)
+			{
+				signx = -1;
+				signy = 1;
+				double slen = sqrt(2*2 + 1*1);
+				sx = (signx*2) / slen;
+				sy = (signy*1) / slen;
+			}	
+			else if(ID == TID_67DEGppB)
+			{
+				signx = 1;
+				signy = 1;
+				double slen = sqrt(2*2 + 1*1);
+				sx = (signx*2) / slen;
+				sy = (signy*1) / slen;
+			}	
+			else
+			{
+				return;
+			}
+		}
+		else
+		{
+			//half-full tile
+			CTYPE = CTYPE_HALF;
+			if(ID == TID_HALFd)
+			{
+				signx = 0;
+				signy = -1;
+				sx = signx;
+				sy = signy;
+			}
+			else if(ID == TID_HALFu)
+			{
+				signx = 0;
+				signy = 1;
+				sx = signx;
+				sy = signy;
+			}
+			else if(ID == TID_HALFl)
+			{
+				signx = 1;
+				signy = 0;
+				sx = signx;
+				sy = signy;
+			}
+			else if(ID == TID_HALFr)
+			{
+				signx = -1;
+				signy = 0;
+				sx = signx;
+				sy = signy;
+			}
+			else
+			{
+				return;
+			}										
+										
+		}
+
+	}
+	else
+	{
+		//TID_EMPTY
+		CTYPE = CTYPE_EMPTY;
+		signx = 0;
+		signy = 0;
+		sx = 0;
+		sy = 0;
+	}
+}
+
+class TileShapeTable
+{
+public:
+	TileShape shapes[TID_COUNT];
+	TileShapeTable()
+	{
+		for( int ID = 0; ID < TID_COUNT; ID++ )
+			ComputeShape(ID, shapes[ID]);
+	}
+};
+
+const TileShape* TileShapes()
+{
+	static TileShapeTable table;
+	return table.shapes;
+}
+
+//these functions are used to update the cell
+//note: ID is assumed to NOT be "empty" state..
+//if it IS the empty state, the tile clears itself
+
+void TileGrid::SetState(const int &k, const int &ID_in)
+{
+	if(ID_in == TID_EMPTY)
+	{
+		Clear(k);
+	}
+	else
+	{
+		//set tile state to a non-emtpy value, and update it's edges and those of the neighbors
+		RollColor(k);
+		id[k] = ID_in;
+		UpdateType(k);
+		UpdateEdges(k);    //(UpdateType() has already told the listener about the new ID)
+		UpdateNeighbors(k);//broadcasts changes to neighboring cells
+	}	
+
+}
+
+//gives a new tile a random color, and the HP that goes with it
+void TileGrid::RollColor(const int &k)
+{
+	int ran = rng.Next()%12;           //random color
+	int color_t;
+
+	if( ran >= 10 )      { hp[k] = 8;  color_t = 2; }
+	else if( ran >= 6 )  { hp[k] = 4;  color_t = 1; }
+	else                 { hp[k] = 2;  color_t = 0; }
+	mat[k] = (mat[k] & ~MAT_COLOR) | color_t;
+}
+
+void TileGrid::Clear(const int &k)
+{
+	//tile was on, turn it off
+	id[k] = TID_EMPTY;
+	UpdateType(k);
+	UpdateEdges(k);//we don't reall need to do this, as this tile's edge states are based only on it's neighbors' states, not on iself
+	UpdateNeighbors(k);
+	Settle(k);
+}
+
+//the ball hit this tile; knock off a hit point, or break it if it's on its last one
+void TileGrid::Hit(const int &k)
+{
+	if( Knock(k) )
+		UpdateBroken();
+}
+
+//Hit(), but if the tile breaks, the edges around it are left for UpdateBroken(),
+//so that a batch of hits (see World::Step()) looks each edge up once, after all
+//of them. returns 1 if the tile broke; a tile that's already empty isn't hit.
+int TileGrid::Knock(const int &k)
+{
+	if( id[k] == TID_EMPTY || (mat[k] & MAT_UNBREAKABLE) )
+		return 0;
+
+	if( hp[k] > 1 ) {
+		hp[k] -= 1;
+		TileChanged(k);
+		return 0;
+	}
+
+	id[k] = TID_EMPTY;
+	UpdateType(k);
+	broken.push_back( CellI(k) );
+	broken.push_back( CellJ(k) );
+	return 1;
+}
+
+//does what Clear() would have done to the edges of every tile Knock() broke,
+//and of their neighbors. the edges between two broken tiles are looked up once,
+//with the tiles already empty, instead of once as each one breaks.
+//
+//the cells are kept as (i,j) rather than k, since a sparse grid can give a
+//broken tile's slot away (Settle()) while the others are still being updated.
+void TileGrid::UpdateBroken()
+{
+	int n = (int)broken.size();
+
+	for( int b = 0; b < n; b += 2 )
+		UpdateEdges( Index(broken[b], broken[b+1]) );
+
+	for( int b = 0; b < n; b += 2 )
+	{
+		int i = broken[b];
+		int j = broken[b+1];
+
+		//a neighbor that broke too has just had all of its edges looked up
+		if( 0 < j && !Broken(i, j-1) )
+			SetNeighborEdge(i, j-1, ESHIFT_D, TID_EMPTY);
+		if( j < fullrows-1 && !Broken(i, j+1) )
+			SetNeighborEdge(i, j+1, ESHIFT_U, TID_EMPTY);
+		if( 0 < i && !Broken(i-1, j) )
+			SetNeighborEdge(i-1, j, ESHIFT_R, TID_EMPTY);
+		if( i < fullcols-1 && !Broken(i+1, j) )
+			SetNeighborEdge(i+1, j, ESHIFT_L, TID_EMPTY);
+	}
+
+	for( int b = 0; b < n; b += 2 )
+		Settle( Index(broken[b], broken[b+1]) );
+
+	broken.clear();
+}
+
+//if (i,j) is waiting for UpdateBroken(); there are only ever a few, so they're just searched
+int TileGrid::Broken(const int &i, const int &j) const
+{
+	for( size_t b = 0; b < broken.size(); b += 2 )
+	{
+		if( broken[b] == i && broken[b+1] == j )
+			return 1;
+	}
+	return 0;
+}
+
+//this function updates neighbor's edge states
+//(i.e if this tile is activated, it's neighbor's edges must be updated to reflect the change..)
+//each neighbor only has one side facing this tile, so only that side is looked up again.
+void TileGrid::UpdateNeighbors(const int &k)
+{
+	int i = CellI(k);
+	int j = CellJ(k);
+	int ID = id[k];
+	
+	if( 0 < j )
+	{
+		SetNeighborEdge(i, j-1, ESHIFT_D, ID);
+	}
+	if( j < fullrows-1 )
+	{
+		SetNeighborEdge(i, j+1, ESHIFT_U, ID);
+	}
+	if( 0 < i )
+	{
+		SetNeighborEdge(i-1, j, ESHIFT_R, ID);
+	}
+	if( i < fullcols-1 )
+	{
+		SetNeighborEdge(i+1, j, ESHIFT_L, ID);
+	}	
+	
+}
+
+//looks up the side (shift) of cell (i,j) that faces a neighbor whose ID is nID.
+//in a sparse grid, empty space only gets a slot if that side turns out not to
+//be off, and gives it back once it's all off again.
+void TileGrid::SetNeighborEdge(const int &i, const int &j, const int &shift, const int &nID)
+{
+	int n = Index(i, j);
+	int e = EdgeLookup(id[n], nID, shift);
+	
+	if( sparse != NULL && n == 0 )
+	{
+		if( e == EID_OFF )
+			return;
+		n = Cell(i, j);
+	}
+	
+	SetEdge(n, shift, e);
+	Settle(n);
+}
+
+//copies the per-ID shape of a tile into the cell's packed arrays
+void TileGrid::UpdateType(const int &k)
+{
+	const TileShape &shape = shapes[ id[k] ];
+	
+	ctype[k] = shape.CTYPE;
+	signs[k] = (shape.signx + 1) | ((shape.signy + 1) << 2);
+	
+	TileChanged(k);
+}
+
+//* UPDATE EDGES -------------------------------------------------------- *//
+
+//the rules for determining edge state are quite complicated; they're all in
+//tileedges.h, which turns them into a table at compile time, so here we only
+//look up each side of the cell against the ID of the neighbor on that side.
+//edges towards missing neighbors (i.e the map's border) are left as they were.
+void TileGrid::UpdateEdges(const int &k)
+{
+	int i = CellI(k);
+	int j = CellJ(k);
+	int ID = id[k];
+	
+	if( 0 < j )
+	{
+		SetEdge(k, ESHIFT_U, EdgeLookup(ID, id[Index(i,j-1)], ESHIFT_U));
+	}
+	if( j < fullrows-1 )
+	{
+		SetEdge(k, ESHIFT_D, EdgeLookup(ID, id[Index(i,j+1)], ESHIFT_D));
+	}
+	if( 0 < i )
+	{
+		SetEdge(k, ESHIFT_L, EdgeLookup(ID, id[Index(i-1,j)], ESHIFT_L));
+	}
+	if( i < fullcols-1 )
+	{
+		SetEdge(k, ESHIFT_R, EdgeLookup(ID, id[Index(i+1,j)], ESHIFT_R));
+	}
+	
+	//edges aren't drawn, so there's nothing to report to the listener here
+}
+
+//* BULK UPDATES -------------------------------------------------------- *//
+
+//these redo UpdateType()/UpdateEdges() for every cell at once, for when most of
+//the grid changed (i.e a level was loaded). they don't tell the listener anything;
+//whoever calls them should send a single MapChanged() when they're done.
+
+void TileGrid::BuildTypes()
+{
+	int n = Stored();
+	for( int k = 0; k < n; k++ )
+	{
+		const TileShape &shape = shapes[ id[k] ];
+		ctype[k] = shape.CTYPE;
+		signs[k] = (shape.signx + 1) | ((shape.signy + 1) << 2);
+	}
+}
+
+//one linear pass over the grid; each cell looks up all 4 of its sides at once
+//(see tileedges.h), so the neighbors don't need to be revisited afterwards.
+//as in UpdateEdges(), sides facing off the map are left as they were.
+void TileGrid::BuildEdges()
+{
+	if( sparse != NULL )
+	{
+		BuildEdgesSparse();
+		return;
+	}
+	
+	const int MASK_U = 3 << ESHIFT_U;
+	const int MASK_D = 3 << ESHIFT_D;
+	const int MASK_L = 3 << ESHIFT_L;
+	const int MASK_R = 3 << ESHIFT_R;
+	
+	int k = 0;
+	for( int j = 0; j < fullrows; j++ )
+	{
+		for( int i = 0; i < fullcols; i++, k++ )
+		{
+			const unsigned char *row = EDGE_TABLE.e[ id[k] ];
+			int e = edges[k];
+			
+			if( 0 < j )          e = (e & ~MASK_U) | (row[ id[k-fullcols] ] & MASK_U);
+			if( j < fullrows-1 ) e = (e & ~MASK_D) | (row[ id[k+fullcols] ] & MASK_D);
+			if( 0 < i )          e = (e & ~MASK_L) | (row[ id[k-1] ] & MASK_L);
+			if( i < fullcols-1 ) e = (e & ~MASK_R) | (row[ id[k+1] ] & MASK_R);
+			
+			edges[k] = e;
+		}
+	}
+}
+
+//BuildEdges() for a sparse grid: every empty cell next to a tile is given a
+//slot first, since its side facing the tile may not be off; then the edges of
+//every slot are looked up as above, and the empty cells that turned out to be
+//all off are let go again.
+void TileGrid::BuildEdgesSparse()
+{
+	const int MASK_U = 3 << ESHIFT_U;
+	const int MASK_D = 3 << ESHIFT_D;
+	const int MASK_L = 3 << ESHIFT_L;
+	const int MASK_R = 3 << ESHIFT_R;
+	
+	int n = Stored();
+	for( int k = 1; k < n; k++ )
+	{
+		if( sparse->IsSpare(k) || id[k] == TID_EMPTY )
+			continue;
+		
+		int i = CellI(k);
+		int j = CellJ(k);
+		if( 0 < j )          Cell(i, j-1);
+		if( j < fullrows-1 ) Cell(i, j+1);
+		if( 0 < i )          Cell(i-1, j);
+		if( i < fullcols-1 ) Cell(i+1, j);
+	}
+	
+	n = Stored();
+	for( int k = 1; k < n; k++ )
+	{
+		if( sparse->IsSpare(k) )
+			continue;
+		
+		int i = CellI(k);
+		int j = CellJ(k);
+		const unsigned char *row = EDGE_TABLE.e[ id[k] ];
+		int e = edges[k];
+		
+		if( 0 < j )          e = (e & ~MASK_U) | (row[ id[Index(i,j-1)] ] & MASK_U);
+		if( j < fullrows-1 ) e = (e & ~MASK_D) | (row[ id[Index(i,j+1)] ] & MASK_D);
+		if( 0 < i )          e = (e & ~MASK_L) | (row[ id[Index(i-1,j)] ] & MASK_L);
+		if( i < fullcols-1 ) e = (e & ~MASK_R) | (row[ id[Index(i+1,j)] ] & MASK_R);
+		
+		edges[k] = e;
+	}
+	
+	for( int k = 1; k < n; k++ )
+	{
+		if( !sparse->IsSpare(k) )
+			Settle(k);
+	}
+}
+
+
+//=============================== TileGrid ====================================
+
+//rows/cols are the integer # of cells in each dimentsion; xw, yw are the halfwidths of each cell
+TileGrid::TileGrid(const int &rows_in, const int &cols_in, const int &xw_in, const int &yw_in)
+{	
+	id = ctype = edges = signs = hp = mat = NULL;
+	file = NULL;
+	sparse = NULL;
+	
+	SetSize(rows_in, cols_in, xw_in, yw_in);
+	killY = KILL_Y;
+	
+	shapes = TileShapes();
+	listener = NULL;
+}
+
+TileGrid::~TileGrid()
+{
+	ClearGrid();
+}
+
+//sets the dimensions of the grid; the planes have to be (re)made to match
+void TileGrid::SetSize(const int &rows_in, const int &cols_in, const int &xw_in, const int &yw_in)
+{
+	xw = xw_in; //store tile halfwidths
+	yw = yw_in;
+	
+	tw = 2*xw; //store tile dimensions
+	th = 2*yw;
+	rows = rows_in;
+	cols = cols_in;
+	fullrows = rows+2;
+	fullcols = cols+2;
+	
+	minX = tw;//world bounds only include the inner part of the grid;
+	minY = th;//not the outside edges.
+	maxX = tw + (rows* tw);
+	maxY = th + (cols* th);
+}
+
+//points the 6 planes at base, which holds Count() bytes for each, back to back
+void TileGrid::SetPlanes(unsigned char *base)
+{
+	int n = Count();
+	id = base;
+	ctype = base + n;
+	edges = base + 2*n;
+	signs = base + 3*n;
+	hp = base + 4*n;
+	mat = base + 5*n;
+}
+
+//gives the grid planes of its own for the current size; all tiles start empty,
+//with every edge off
+void TileGrid::Alloc()
+{
+	int n = Count();
+	
+	ClearGrid();
+	
+	store.assign(LEVEL_PLANES*n, 0);
+	SetPlanes(&store[0]);
+	
+	memset(id, TID_EMPTY, n);
+	memset(ctype, CTYPE_EMPTY, n);
+	memset(signs, (0+1) | ((0+1) << 2), n);
+}
+
+//Build the TileMap
+void TileGrid::Build()
+{	
+	//build raw tiles
+	Alloc();
+	
+	//(neighbors don't need linking anymore, they're found by index)
+
+	BuildBorder();
+}
+
+//Build the TileMap, keeping only the cells that aren't empty space (see
+//sparsetiles.h); memory then grows with the number of tiles, not with the area
+void TileGrid::BuildSparse()
+{
+	ClearGrid();
+	
+	sparse = new SparseTiles();
+	Repoint();
+	
+	BuildBorder();
+}
+
+//fills the border with unbreakable tiles; each cell is looked up (and maybe
+//given a slot) before its planes are touched, since that can move them
+void TileGrid::BuildBorder()
+{
+	//fill top border tiles	
+	for( int i = 0; i < fullcols; i++)
+	{
+		int k = Cell(i,0);
+		mat[k] |= MAT_UNBREAKABLE;
+		SetState(k, TID_FULL);
+	}
+/* --- Bottom border are off.
+	//fill bottom border tiles
+	for( int i = 0; i < fullcols; i++)
+	{
+		int k = Cell(i,fullrows-1);
+		mat[k] |= MAT_UNBREAKABLE;
+		SetState(k, TID_FULL);
+	}
+*/
+	//fill left border tiles
+	for( int i = 0; i < fullrows; i++)
+	{
+		int k = Cell(0,i);
+		mat[k] |= MAT_UNBREAKABLE;
+		SetState(k, TID_FULL);
+	}
+	
+	//fill right border tiles		
+	for( int i = 0; i < fullrows; i++)
+	{
+		int k = Cell(fullcols-1,i);
+		mat[k] |= MAT_UNBREAKABLE;
+		SetState(k, TID_FULL);
+	}
+	
+}
+
+//empties the grid
+void TileGrid::ClearGrid()
+{
+	id = ctype = edges = signs = hp = mat = NULL;
+	store.clear();
+	
+	delete file;
+	file = NULL;
+	
+	delete sparse;
+	sparse = NULL;
+}
+
+//points the 6 planes at the sparse store's, which move whenever it gets a new slot
+void TileGrid::Repoint()
+{
+	id = &sparse->id[0];
+	ctype = &sparse->ctype[0];
+	edges = &sparse->edges[0];
+	signs = &sparse->signs[0];
+	hp = &sparse->hp[0];
+	mat = &sparse->mat[0];
+}
+
+//returns the index of cell (i,j) for writing to it. that's just Index() for a
+//dense grid; a sparse one gives the cell a slot first, if it had none (which
+//can move the planes, so don't hold on to pointers into them across this).
+int TileGrid::Cell(const int &i, const int &j)
+{
+	if( sparse == NULL )
+		return Index(i, j);
+	
+	int slots = sparse->Slots();
+	int k = sparse->Insert(i, j);
+	if( sparse->Slots() != slots )
+		Repoint();
+	return k;
+}
+
+//a sparse grid lets go of cell k if it's become plain empty space again
+void TileGrid::Settle(const int &k)
+{
+	if( sparse != NULL && k != 0 && id[k] == TID_EMPTY && edges[k] == 0 )
+		sparse->Remove(k);
+}
+
+//memory held by the planes, in bytes
+size_t TileGrid::Bytes() const
+{
+	if( sparse != NULL )
+		return sparse->Bytes();
+	return (size_t)LEVEL_PLANES*Count();
+}
+
+	
+//-------------------------------- tile access operators -----------------------
+
+//returns a referance to the tile touching point x,y; scalar version
+TileRef TileGrid::GetTile_S(const double &x, const double &y)
+{
+	return TileRef(this, (int)(x / tw), (int)(y / th) );
+}
+//vector version
+TileRef TileGrid::GetTile_V(const Vector2 &p)
+{
+	return TileRef(this, (int)(p.x/tw), (int)(p.y/th) );
+}
+//index-based version
+TileRef TileGrid::GetTile_I(const int &i, const int &j)
+{
+	return TileRef(this, i, j); //note!! this will break if i or j is out of bounds!!!
+}
+//flat-index version
+TileRef TileGrid::GetTile_K(const int &k)
+{
+	return TileRef(this, CellI(k), CellJ(k));
+}
+
+//fills vector v with grid coordinates (i.e the cell index) of the tile at point x,y (scalar version)
+void TileGrid::GetIndex_S(Vector2 &v, const int &x, const int &y)
+{
+	v.x = (int)(x / tw);
+	v.y = (int)(y / th);
+}
+void TileGrid::GetIndex_V(Vector2 &v, const Vector2 &p)
+{
+	v.x = (int)(p.x/tw);
+	v.y = (int)(p.y/th);
+}
+
+//these functions tokenize the tile states; currently they're assuming that
+//the current state of the tilemap (i.e dimensions) are constant, i.e
+//theyr'e not saved/loaded with the tile states.
+//
+//later we should change this.
+//
+//NOTE: the char with code 0 is apparently backspace or something.. so we pad the charcodes to get them in
+//		a "normal" range.. (alphanumerics start at 48, upper case at 65)
+//NOTE: the "\" works with input text, but acts like an escape character in code!! so, avoid it (ascii#92)
+
+//returns a string of ascii characters, where each char is the tokenized description of a
+//tile in the tilemap
+
+
+std::string TileGrid::GetTileStates()
+{
+
+	string output = "";
+
+	for(int i = 1; i < cols+1; i++)
+	{
+		for(int j = 1; j < rows+1; j++)
+		{
+			output += id[ Index(i,j) ] + CHAR_PAD;			
+		}
+	}	
+	
+	return output;
+}
+
+//sets a single tile state
+void TileGrid::SetTileState(const int &i, const int &j, const char &ch)
+{
+	
+	SetState( Cell(i+1,j+1), ch - CHAR_PAD );
+}
+
+//each char in the string is assumed to be a tokenized tile-type ID, in the same
+//order GetTileStates() writes them.
+//
+//this loads the whole level in bulk: all the IDs (and colors) are written first,
+//then the types, then the edges in one pass, and the listener hears about it once.
+//going through SetState() per cell would redo the edges of every cell 5 times
+//and send a TileChanged() for each one.
+void TileGrid::SetTileStates(const string &instr)
+{
+	
+	for(int i = 0; i < cols; i++)
+	{
+		for(int j = 0; j < rows; j++)
+		{
+			int ID = instr[ i*rows + j ] - CHAR_PAD;
+			int k = (ID != TID_EMPTY) ? Cell(i+1,j+1) : Index(i+1,j+1);//empty space isn't given a slot
+			if( k == 0 && sparse != NULL )
+				continue;//it's already empty
+			
+			if( ID != TID_EMPTY )
+				RollColor(k);//same order of rng calls as SetState() would make
+			id[k] = ID;
+		}
+	}	
+	
+	BuildTypes();
+	BuildEdges();
+	
+	MapChanged();
+}
+
+//replaces the grid (dimensions and all) with a level file, which is mapped and
+//used as it is; nothing is parsed or recomputed, only checked once (see
+//LevelFile::Open()), which is a single pass over 3 of the planes. returns false
+//(leaving the grid alone) if the file can't be read or doesn't check out.
+bool TileGrid::LoadLevelFile(const string &filename)
+{
+	LevelFile *f = new LevelFile();
+	if( !f->Open(filename) )
+	{
+		delete f;
+		return false;
+	}
+
+	ClearGrid();
+	SetSize(f->rows, f->cols, f->xw, f->yw);
+	file = f;
+	SetPlanes( f->Planes() );
+
+	MapChanged();
+	return true;
+}
+
+//writes the grid as a level file, i.e what GetTileStates() does for level strings
+bool TileGrid::SaveLevelFile(const string &filename) const
+{
+	return LevelFile::Write(filename, *this);
+}
+
+//forwards a change in a tile's ID/HP to whoever is listening (i.e the view)
+void TileGrid::TileChanged(const int &k)
+{
+	if( listener != NULL )
+		listener->TileChanged( GetTile_K(k) );
+}
+
+//tells whoever is listening that any/every tile may have changed
+void TileGrid::MapChanged()
+{
+	if( listener != NULL )
+		listener->MapChanged( this );
+}
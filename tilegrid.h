@@ -0,0 +1,277 @@
+//* tilegrid.h *//
+
+#ifndef TILEGRID_H
+#define TILEGRID_H
+
+#include <vector>
+#include <string>
+#include <cstddef>
+
+#include "vector2.h"
+#include "random.h"
+#include "sparsetiles.h"
+
+//TILETYPE ENUMERATION
+enum TILE_ID {
+	TID_EMPTY = 0,
+	TID_FULL = 1,//fullAABB tile
+	TID_45DEGpn = 2,//45-degree triangle, whose normal is (+ve,-ve)
+	TID_45DEGnn = 3,//(+ve,+ve)
+	TID_45DEGnp = 4,//(-ve,+ve)
+	TID_45DEGpp = 5,//(-ve,-ve)
+	TID_CONCAVEpn = 6,//1/4-circle cutout
+	TID_CONCAVEnn = 7,
+	TID_CONCAVEnp = 8,
+	TID_CONCAVEpp = 9,
+	TID_CONVEXpn = 10,//1/4/circle
+	TID_CONVEXnn = 11,
+	TID_CONVEXnp = 12,
+	TID_CONVEXpp = 13,
+	TID_22DEGpnS = 14,//22.5 degree slope
+	TID_22DEGnnS = 15,
+	TID_22DEGnpS = 16,
+	TID_22DEGppS = 17,
+	TID_22DEGpnB = 18,
+	TID_22DEGnnB = 19,
+	TID_22DEGnpB = 20,
+	TID_22DEGppB = 21,
+	TID_67DEGpnS = 22,//67.5 degree slope
+	TID_67DEGnnS = 23,
+	TID_67DEGnpS = 24,
+	TID_67DEGppS = 25,
+	TID_67DEGpnB = 26,
+	TID_67DEGnnB = 27,
+	TID_67DEGnpB = 28,
+	TID_67DEGppB = 29,
+	TID_HALFd = 30,//half-full tiles
+	TID_HALFr = 31,
+	TID_HALFu = 32,
+	TID_HALFl = 33
+};
+
+
+//collision shape  "types"
+enum COLLISION_TYPE {
+	CTYPE_EMPTY = 0,
+	CTYPE_FULL = 1,
+	CTYPE_45DEG = 2,
+	CTYPE_CONCAVE = 6,
+	CTYPE_CONVEX = 10,
+	CTYPE_22DEGs = 14,
+	CTYPE_22DEGb = 18,
+	CTYPE_67DEGs = 22,
+	CTYPE_67DEGb = 26,
+	CTYPE_HALF = 30
+};
+
+//---- edge state enumeration
+enum EDGE_ID {
+	EID_OFF = 0,
+	EID_INTERESTING = 1,
+	EID_SOLID = 2
+};
+
+const int CHAR_PAD = 48;
+
+const int TID_COUNT = 34;//number of TILE_IDs
+
+//CTYPE, signx/signy and the slope normal (sx,sy) depend only on the tile ID,
+//so they're worked out once per ID (see TileShapes()) instead of once per cell
+struct TileShape
+{
+	int CTYPE;
+	int signx;
+	int signy;
+	double sx;
+	double sy;
+};
+
+const TileShape* TileShapes();//TID_COUNT entries, indexed by TILE_ID
+
+//the 4 edge states of a cell are packed 2 bits each into one byte
+enum EDGE_SHIFT {
+	ESHIFT_U = 0,
+	ESHIFT_D = 2,
+	ESHIFT_L = 4,
+	ESHIFT_R = 6
+};
+
+const int MAT_COLOR = 0x03;//low bits of the mat byte are the tile's color_t
+const int MAT_UNBREAKABLE = 0x80;
+
+const double KILL_Y = 380;//default TileGrid::killY; just above the bottom of the game's 8x8 board
+
+class WorldListener;
+class TileRef;
+class LevelFile;
+
+//this object manages a grid of static AABB tiles, without any widgets attached.
+//
+//cells are stored structure-of-arrays, row-major (k = j*fullcols + i, i is the
+//column and j the row), one byte per property; a cell costs 6 bytes in total.
+//neighbors are found by index arithmetic, and callers get TileRef handles
+//instead of pointers to cell objects.
+//
+//the 6 arrays ("planes") are laid out back to back, either in memory the grid
+//owns (Build()) or in a mapped level file (LoadLevelFile(), see levelfile.h).
+//
+//a mostly-empty grid can keep only the cells that aren't empty space instead
+//(BuildSparse(), see sparsetiles.h); then k is a slot rather than j*fullcols + i,
+//and Index() returns the shared empty sentinel for the cells that aren't kept.
+//cells are written through Cell(), which gives them a slot if they need one.
+class TileGrid
+{
+
+public:
+
+	int xw; //store tile halfwidths
+	int yw;
+
+	int tw; //store tile dimensions
+	int th;
+	int rows;
+	int cols;
+	int fullrows;
+	int fullcols;
+
+	int minX;//world bounds only include the inner part of the grid;
+	int minY;//not the outside edges.
+	int maxX;
+	int maxY;
+
+	double killY;//bodies that fall below this die (the bottom of the board is open)
+
+	unsigned char *id;//TILE_ID
+	unsigned char *ctype;//COLLISION_TYPE
+	unsigned char *edges;//EDGE_IDs, packed by EDGE_SHIFT
+	unsigned char *signs;//(signx+1) | (signy+1)<<2
+	unsigned char *hp;
+	unsigned char *mat;//color_t | MAT_UNBREAKABLE
+
+	std::vector< unsigned char > store;//backs the planes, when the grid owns them
+	LevelFile *file;//the level the planes are mapped from, or NULL
+	SparseTiles *sparse;//holds the planes of a sparse grid, or NULL
+
+	const TileShape *shapes;
+
+	Random rng;//rolls the colors of new tiles
+
+	WorldListener *listener;//told about tile changes; may be NULL
+
+	TileGrid(const int &rows_in, const int &cols_in, const int &xw_in, const int &yw_in);
+	~TileGrid();
+
+	void SetSize(const int &rows_in, const int &cols_in, const int &xw_in, const int &yw_in);
+	void SetPlanes(unsigned char *base);
+	void Alloc();
+	void Build();
+	void BuildSparse();
+	void ClearGrid();
+
+	inline int Index(const int &i, const int &j) const { return (sparse == NULL) ? j*fullcols + i : sparse->Find(i, j); }
+	inline int CellI(const int &k) const { return (sparse == NULL) ? k % fullcols : sparse->I(k); }
+	inline int CellJ(const int &k) const { return (sparse == NULL) ? k / fullcols : sparse->J(k); }
+	inline int Count() const { return fullrows*fullcols; }
+	inline int Stored() const { return (sparse == NULL) ? Count() : sparse->Slots(); }//entries in each plane
+	int Cell(const int &i, const int &j);
+	size_t Bytes() const;
+
+	TileRef GetTile_S(const double &x, const double &y);
+	TileRef GetTile_V(const Vector2 &p);
+	TileRef GetTile_I(const int &i, const int &j);
+	TileRef GetTile_K(const int &k);
+
+	void GetIndex_S(Vector2 &v, const int &x, const int &y);
+	void GetIndex_V(Vector2 &v, const Vector2 &p);
+
+	void SetState(const int &k, const int &ID_in);
+	void Clear(const int &k);
+	void Hit(const int &k);
+	int Knock(const int &k);
+	void UpdateBroken();
+	void UpdateNeighbors(const int &k);
+	void UpdateType(const int &k);
+	void UpdateEdges(const int &k);
+	void RollColor(const int &k);
+	void BuildTypes();
+	void BuildEdges();
+	inline void SetEdge(const int &k, const int &shift, const int &e) { edges[k] = (edges[k] & ~(3 << shift)) | (e << shift); }
+	void SetNeighborEdge(const int &i, const int &j, const int &shift, const int &nID);
+
+	std::string GetTileStates();
+	void SetTileState(const int &i, const int &j, const char &ch);
+	void SetTileStates(const std::string &instr);
+
+	bool LoadLevelFile(const std::string &filename);
+	bool SaveLevelFile(const std::string &filename) const;
+
+	void TileChanged(const int &k);
+	void MapChanged();
+
+private:
+
+	std::vector< int > broken;//i, j of each tile Knock() broke that's waiting for UpdateBroken()
+
+	void BuildBorder();
+	void BuildEdgesSparse();
+	void Repoint();
+	void Settle(const int &k);
+	int Broken(const int &i, const int &j) const;
+
+	TileGrid(const TileGrid&);//not copyable; the planes may belong to a mapping
+	TileGrid& operator=(const TileGrid&);
+
+};
+
+
+//a TileRef is a lightweight handle to one cell of a TileGrid; it reads the
+//cell's packed state through the accessors below, which are named after the
+//fields the old TileMapCell had. a default-constructed TileRef is "null"
+//(i.e the neighbor of a border cell, or the pad, which isn't a tile).
+class TileRef
+{
+
+public:
+
+	TileGrid *map;
+	int i;
+	int j;
+	int k;
+
+	TileRef() { map = NULL; i = j = k = -1; }
+	TileRef(TileGrid *map_in, const int &i_in, const int &j_in) { map = map_in; i = i_in; j = j_in; k = map->Index(i, j); }
+
+	inline bool IsNull() const { return map == NULL; }
+
+	inline int ID() const { return map->id[k]; }
+	inline int CTYPE() const { return map->ctype[k]; }
+	inline int signx() const { return (map->signs[k] & 3) - 1; }
+	inline int signy() const { return ((map->signs[k] >> 2) & 3) - 1; }
+	inline double sx() const { return map->shapes[ map->id[k] ].sx; }
+	inline double sy() const { return map->shapes[ map->id[k] ].sy; }
+
+	inline int eU() const { return (map->edges[k] >> ESHIFT_U) & 3; }
+	inline int eD() const { return (map->edges[k] >> ESHIFT_D) & 3; }
+	inline int eL() const { return (map->edges[k] >> ESHIFT_L) & 3; }
+	inline int eR() const { return (map->edges[k] >> ESHIFT_R) & 3; }
+
+	inline int HP() const { return map->hp[k]; }
+	inline int color_t() const { return map->mat[k] & MAT_COLOR; }
+	inline int unbreakable() const { return (map->mat[k] & MAT_UNBREAKABLE) != 0; }
+
+	inline int xw() const { return map->xw; }
+	inline int yw() const { return map->yw; }
+	inline double x() const { return map->xw + i*map->tw; }//center of the cell
+	inline double y() const { return map->yw + j*map->th; }
+
+	inline TileRef nU() const { return (0 < j) ? TileRef(map, i, j-1) : TileRef(); }
+	inline TileRef nD() const { return (j < map->fullrows-1) ? TileRef(map, i, j+1) : TileRef(); }
+	inline TileRef nL() const { return (0 < i) ? TileRef(map, i-1, j) : TileRef(); }
+	inline TileRef nR() const { return (i < map->fullcols-1) ? TileRef(map, i+1, j) : TileRef(); }
+
+	inline void Hit() const { map->Hit(k); }
+
+};
+
+
+#endif //TILEGRID_H
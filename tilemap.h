@@ -4,58 +4,48 @@
 #define TILEMAP_H
 
 #include <QWidget>
+#include <QImage>
+#include <QRect>
+#include <vector>
 
-const int CHAR_PAD = 48;
+#include "tileatlas.h"
 
-class TileMapCell;
-class Vector2;
+class TileGrid;
+class TileRef;
 
+//view of a TileGrid (tilegrid.h); the whole map is one widget, drawn from a
+//canvas that holds every tile
 class TileMap : public QWidget
 {
 	Q_OBJECT
 	
 private:
 
+	void Redraw();
+	void RedrawCell(QPainter &painter, const int &i, const int &j);
+	QRect CellRect(const int &i, const int &j) const;
 
 protected:
-	//void paintEvent(QPaintEvent * /* event */);
+	void paintEvent(QPaintEvent *event);
 
 
 public:
 
-	int xw; //store tile halfwidths
-	int yw;
+	TileGrid *model;
 	
-	int tw; //store tile dimensions
-	int th;
-	int rows;
-	int cols;
-	int fullrows;
-	int fullcols;
-	
-	int minX;//world bounds only include the inner part of the grid;
-	int minY;//not the outside edges.
-	int maxX;
-	int maxY;
-	
-	std::vector< std::vector < TileMapCell* > > grid;
+	TileAtlas atlas;//every look of every tile, at the grid's tile size
+	QImage canvas;//every tile, already drawn; painting the map only copies from it
+	std::vector< int > dirty;//cells (j*fullcols + i) whose look changed since the canvas was drawn
+	int stale;//the whole canvas has to be drawn again
 
-	TileMap(const int &rows_in, const int &cols_in, const int &xw_in, const int &yw_in, QWidget *parent = 0);
+	TileMap(TileGrid *model_in, QWidget *parent = 0);
 	~TileMap();
 
 	void Build();
 	void ClearGrid();
 	
-	TileMapCell* GetTile_S(const double &x, const double &y);
-	TileMapCell* GetTile_V(const Vector2 &p);
-	TileMapCell* GetTile_I(const int &i, const int &j);
-	
-	void GetIndex_S(Vector2 &v, const int &x, const int &y);
-	void GetIndex_V(Vector2 &v, const Vector2 &p);
-	
-	std::string GetTileStates();
-	void SetTileState(const int &i, const int &j, const char &ch);
-	void SetTileStates(const std::string &instr);
+	void TileChanged(const TileRef &t);
+	void MapChanged();
 
 };
 
@@ -5,42 +5,138 @@
 #define VECTOR2_H
 
 #include <string>
+#include <sstream>
+#include <cmath>
 
 using namespace std;
 
-class Vector2
+//a 2D vector of T (Vector2 is the double one; see BodyT for float). everything
+//is defined here, so it all inlines; it has no destructor or copy of its own, so
+//it's trivially copyable and can be kept in arrays and memcpy'd like a pair of
+//Ts. the named methods are the old interface; the operators do the same
+//arithmetic, in the same order.
+template<class T> class Vector2T
 {
 private:
-	
+
 
 public:
-	
-	double x,y;
-
-	Vector2() { x = y = 0 ; }
-	Vector2(const double &x_in, const double &y_in);  //ctor
-	~Vector2(); //dector
-	
-	string ToString();
-	
-	Vector2 clone();
-	Vector2 plus(const Vector2 &v2);
-	Vector2 minus(const Vector2 &v2);
-	Vector2 normR();
-	Vector2 dir();
-	Vector2 proj(Vector2 v2);
-	
-	double projLen(Vector2 v2);
-	double dot(const Vector2 &v2);
-	double cross(const Vector2 &v2);
-	double len();
-	
-	void copy(const Vector2 &v2);
-	void mult(const double &s);
-	void normalize();
-	void pluseq(const Vector2 &v2);
-	void minuseq(const Vector2 &v2);
-	
+
+	T x,y;
+
+	constexpr Vector2T() : x(0), y(0) { }
+	constexpr Vector2T(const T &x_in, const T &y_in) : x(x_in), y(y_in) { }  //ctor
+	template<class U> explicit constexpr Vector2T(const Vector2T<U> &v) : x((T)v.x), y((T)v.y) { }//from another precision
+
+	//(returns a formatted string containing x,y)
+	string ToString() const
+	{
+		ostringstream oss;
+		oss << "(" << x << "," << y << ")" << std::endl;
+		return oss.str();
+	}
+
+
+	//----- these functions return Vector2s -----
+
+	constexpr Vector2T clone() const { return Vector2T(x, y); }//return a copy of this
+	constexpr Vector2T plus(const Vector2T &v2) const { return Vector2T( x + v2.x, y + v2.y ); }//return this+v2
+	constexpr Vector2T minus(const Vector2T &v2) const { return Vector2T( x - v2.x, y - v2.y ); }//return this-v2
+	constexpr Vector2T normR() const { return Vector2T( -y, x ); }//return the righthand normal of this
+
+	//return the (unit) direction vector of this
+	Vector2T dir() const
+	{
+		Vector2T v = clone();
+		v.normalize();
+		return v;
+	}
+
+	//return this projected _onto_ v2
+	Vector2T proj(const Vector2T &v2) const
+	{
+		T den = v2.dot(v2);
+		if( den == 0 )
+		{
+			//zero-length v2
+			//"WARNING! Vector2T.proj() was given a zero-length projection vector!"
+			return clone();//not sure how to gracefully recover but, hopefully this will be okay
+		}
+
+		Vector2T v = v2.clone();
+		v.mult( dot(v2) / den );
+		return v;
+	}
+
+
+	//----- these functions return scalars -----
+
+	//return the magnitude (absval) of this projected onto v2
+	T projLen(const Vector2T &v2) const
+	{
+		T den = v2.dot(v2);
+		if( den == 0 )
+		{
+			//zero-length v2
+			//"WARNING! Vector2T.projLen() was given a zero-length projection vector!"
+			return 0;
+		}
+		return fabs( dot(v2) / den );
+	}
+
+	constexpr T dot(const Vector2T &v2) const { return (x * v2.x) + (y * v2.y); }//return the dotprod of this and v2
+
+	//return the crossprod of this and v2
+	//note that this is equivalent to the dotprod of this and the lefthand normal of v2
+	constexpr T cross(const Vector2T &v2) const { return (x * v2.y) - (y * v2.x); }
+
+	T len() const { return sqrt( (x*x) + (y*y) ); }///return the length of this
+
+
+	//----- these functions return nothing (they operate on this) -----
+
+	constexpr void copy(const Vector2T &v2) { x = v2.x; y = v2.y; }//change this to a duplicate of v2
+	constexpr void mult(const T &s) { x *= s; y *= s; }//multiply this by a scalar s
+	constexpr void pluseq(const Vector2T &v2) { x += v2.x; y += v2.y; }//add v2 to this
+	constexpr void minuseq(const Vector2T &v2) { x -= v2.x; y -= v2.y; }//subtract v2 from this
+
+	//convert this vector to a unit/direction vector
+	void normalize()
+	{
+		T L = len();
+		if( L != 0 )
+		{
+			x /= L;
+			y /= L;
+		}
+		else
+		{
+			//"WARNING! Vector2T.normalize() was called on a zero-length vector!"
+		}
+	}
+
+
+	//----- operators -----
+
+	constexpr Vector2T operator+(const Vector2T &v2) const { return Vector2T( x + v2.x, y + v2.y ); }
+	constexpr Vector2T operator-(const Vector2T &v2) const { return Vector2T( x - v2.x, y - v2.y ); }
+	constexpr Vector2T operator-() const { return Vector2T( -x, -y ); }
+	constexpr Vector2T operator*(const T &s) const { return Vector2T( x * s, y * s ); }
+	constexpr Vector2T operator/(const T &s) const { return Vector2T( x / s, y / s ); }
+
+	constexpr Vector2T& operator+=(const Vector2T &v2) { x += v2.x; y += v2.y; return *this; }
+	constexpr Vector2T& operator-=(const Vector2T &v2) { x -= v2.x; y -= v2.y; return *this; }
+	constexpr Vector2T& operator*=(const T &s) { x *= s; y *= s; return *this; }
+	constexpr Vector2T& operator/=(const T &s) { x /= s; y /= s; return *this; }
+
+	constexpr bool operator==(const Vector2T &v2) const { return x == v2.x && y == v2.y; }
+	constexpr bool operator!=(const Vector2T &v2) const { return x != v2.x || y != v2.y; }
+
 };
 
+//s*v, the same as v*s
+template<class T> constexpr Vector2T<T> operator*(const T &s, const Vector2T<T> &v) { return Vector2T<T>( s * v.x, s * v.y ); }
+
+typedef Vector2T< double > Vector2;
+
 #endif   // VECTOR2_H
@@ -0,0 +1,176 @@
+//* vector2x.h *//
+
+#ifndef VECTOR2X_H
+#define VECTOR2X_H
+
+#include <cmath>
+#include <stdint.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "vector2.h"
+
+//packed doubles for batch math: Double4 is 4 lanes, one AVX2 register (or two
+//SSE2 ones, or a plain array without either), and Double8 is two Double4s.
+//
+//every operation is done lane by lane with the same IEEE double arithmetic as
+//the scalar code, so a batch written in the same order as a scalar loop gives
+//exactly the same results. masks are lanes with all bits set (true) or clear
+//(false), like BodySet::alive.
+class Double4
+{
+
+public:
+
+#if defined(__AVX2__)
+	__m256d v;
+
+	Double4() { }
+	explicit Double4(const __m256d &v_in) : v(v_in) { }
+	explicit Double4(const double &s) : v(_mm256_set1_pd(s)) { }
+
+	static Double4 Load(const double *p) { return Double4( _mm256_loadu_pd(p) ); }
+	static Double4 LoadMask(const int64_t *p) { return Double4( _mm256_castsi256_pd( _mm256_loadu_si256( (const __m256i*)p ) ) ); }
+	void Store(double *p) const { _mm256_storeu_pd(p, v); }
+
+	Double4 operator+(const Double4 &b) const { return Double4( _mm256_add_pd(v, b.v) ); }
+	Double4 operator-(const Double4 &b) const { return Double4( _mm256_sub_pd(v, b.v) ); }
+	Double4 operator*(const Double4 &b) const { return Double4( _mm256_mul_pd(v, b.v) ); }
+	Double4 operator/(const Double4 &b) const { return Double4( _mm256_div_pd(v, b.v) ); }
+
+	friend Double4 Sqrt(const Double4 &a) { return Double4( _mm256_sqrt_pd(a.v) ); }
+	friend Double4 Less(const Double4 &a, const Double4 &b) { return Double4( _mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ) ); }
+	friend Double4 Select(const Double4 &m, const Double4 &a, const Double4 &b) { return Double4( _mm256_blendv_pd(b.v, a.v, m.v) ); }
+#elif defined(__SSE2__)
+	__m128d lo, hi;
+
+	Double4() { }
+	Double4(const __m128d &lo_in, const __m128d &hi_in) : lo(lo_in), hi(hi_in) { }
+	explicit Double4(const double &s) : lo(_mm_set1_pd(s)), hi(_mm_set1_pd(s)) { }
+
+	static Double4 Load(const double *p) { return Double4( _mm_loadu_pd(p), _mm_loadu_pd(p + 2) ); }
+	static Double4 LoadMask(const int64_t *p) { return Double4( _mm_castsi128_pd( _mm_loadu_si128( (const __m128i*)p ) ), _mm_castsi128_pd( _mm_loadu_si128( (const __m128i*)(p + 2) ) ) ); }
+	void Store(double *p) const { _mm_storeu_pd(p, lo); _mm_storeu_pd(p + 2, hi); }
+
+	Double4 operator+(const Double4 &b) const { return Double4( _mm_add_pd(lo, b.lo), _mm_add_pd(hi, b.hi) ); }
+	Double4 operator-(const Double4 &b) const { return Double4( _mm_sub_pd(lo, b.lo), _mm_sub_pd(hi, b.hi) ); }
+	Double4 operator*(const Double4 &b) const { return Double4( _mm_mul_pd(lo, b.lo), _mm_mul_pd(hi, b.hi) ); }
+	Double4 operator/(const Double4 &b) const { return Double4( _mm_div_pd(lo, b.lo), _mm_div_pd(hi, b.hi) ); }
+
+	friend Double4 Sqrt(const Double4 &a) { return Double4( _mm_sqrt_pd(a.lo), _mm_sqrt_pd(a.hi) ); }
+	friend Double4 Less(const Double4 &a, const Double4 &b) { return Double4( _mm_cmplt_pd(a.lo, b.lo), _mm_cmplt_pd(a.hi, b.hi) ); }
+
+	//SSE2 has no blend; select with and/andnot/or instead
+	friend Double4 Select(const Double4 &m, const Double4 &a, const Double4 &b)
+	{
+		return Double4( _mm_or_pd( _mm_and_pd(m.lo, a.lo), _mm_andnot_pd(m.lo, b.lo) ),
+						_mm_or_pd( _mm_and_pd(m.hi, a.hi), _mm_andnot_pd(m.hi, b.hi) ) );
+	}
+#else
+	double v[4];
+
+	Double4() { }
+	explicit Double4(const double &s) { v[0] = v[1] = v[2] = v[3] = s; }
+
+	static Double4 Load(const double *p) { Double4 a; for( int n = 0; n < 4; n++ ) a.v[n] = p[n]; return a; }
+	static Double4 LoadMask(const int64_t *p) { Double4 a; for( int n = 0; n < 4; n++ ) a.v[n] = p[n] ? 1 : 0; return a; }
+	void Store(double *p) const { for( int n = 0; n < 4; n++ ) p[n] = v[n]; }
+
+	Double4 operator+(const Double4 &b) const { Double4 a; for( int n = 0; n < 4; n++ ) a.v[n] = v[n] + b.v[n]; return a; }
+	Double4 operator-(const Double4 &b) const { Double4 a; for( int n = 0; n < 4; n++ ) a.v[n] = v[n] - b.v[n]; return a; }
+	Double4 operator*(const Double4 &b) const { Double4 a; for( int n = 0; n < 4; n++ ) a.v[n] = v[n] * b.v[n]; return a; }
+	Double4 operator/(const Double4 &b) const { Double4 a; for( int n = 0; n < 4; n++ ) a.v[n] = v[n] / b.v[n]; return a; }
+
+	//without SIMD a mask lane is just 1 or 0
+	friend Double4 Sqrt(const Double4 &a) { Double4 s; for( int n = 0; n < 4; n++ ) s.v[n] = sqrt(a.v[n]); return s; }
+	friend Double4 Less(const Double4 &a, const Double4 &b) { Double4 m; for( int n = 0; n < 4; n++ ) m.v[n] = (a.v[n] < b.v[n]) ? 1 : 0; return m; }
+	friend Double4 Select(const Double4 &m, const Double4 &a, const Double4 &b) { Double4 s; for( int n = 0; n < 4; n++ ) s.v[n] = (m.v[n] != 0) ? a.v[n] : b.v[n]; return s; }
+#endif
+
+	Double4& operator+=(const Double4 &b) { return *this = *this + b; }
+	Double4& operator-=(const Double4 &b) { return *this = *this - b; }
+	Double4& operator*=(const Double4 &b) { return *this = *this * b; }
+
+	double operator[](const int &n) const { double a[4]; Store(a); return a[n]; }
+
+};
+
+//8 lanes, as two Double4s
+class Double8
+{
+
+public:
+
+	Double4 lo, hi;
+
+	Double8() { }
+	Double8(const Double4 &lo_in, const Double4 &hi_in) : lo(lo_in), hi(hi_in) { }
+	explicit Double8(const double &s) : lo(s), hi(s) { }
+
+	static Double8 Load(const double *p) { return Double8( Double4::Load(p), Double4::Load(p + 4) ); }
+	static Double8 LoadMask(const int64_t *p) { return Double8( Double4::LoadMask(p), Double4::LoadMask(p + 4) ); }
+	void Store(double *p) const { lo.Store(p); hi.Store(p + 4); }
+
+	Double8 operator+(const Double8 &b) const { return Double8( lo + b.lo, hi + b.hi ); }
+	Double8 operator-(const Double8 &b) const { return Double8( lo - b.lo, hi - b.hi ); }
+	Double8 operator*(const Double8 &b) const { return Double8( lo * b.lo, hi * b.hi ); }
+	Double8 operator/(const Double8 &b) const { return Double8( lo / b.lo, hi / b.hi ); }
+
+	Double8& operator+=(const Double8 &b) { return *this = *this + b; }
+	Double8& operator-=(const Double8 &b) { return *this = *this - b; }
+	Double8& operator*=(const Double8 &b) { return *this = *this * b; }
+
+	double operator[](const int &n) const { return (n < 4) ? lo[n] : hi[n - 4]; }
+
+	friend Double8 Sqrt(const Double8 &a) { return Double8( Sqrt(a.lo), Sqrt(a.hi) ); }
+	friend Double8 Less(const Double8 &a, const Double8 &b) { return Double8( Less(a.lo, b.lo), Less(a.hi, b.hi) ); }
+	friend Double8 Select(const Double8 &m, const Double8 &a, const Double8 &b) { return Double8( Select(m.lo, a.lo, b.lo), Select(m.hi, a.hi, b.hi) ); }
+
+};
+
+//N Vector2s at once, structure-of-arrays: lane n is (x[n], y[n]). they're
+//loaded from and stored to separate x and y arrays, the way BodySet keeps them.
+//the operators match Vector2's, lane by lane.
+template<class D> class Vector2xN
+{
+
+public:
+
+	D x, y;
+
+	Vector2xN() { }
+	Vector2xN(const D &x_in, const D &y_in) : x(x_in), y(y_in) { }
+	explicit Vector2xN(const Vector2 &v) : x(v.x), y(v.y) { }//v in every lane
+
+	static Vector2xN Load(const double *px, const double *py) { return Vector2xN( D::Load(px), D::Load(py) ); }
+	void Store(double *px, double *py) const { x.Store(px); y.Store(py); }
+
+	Vector2 Get(const int &n) const { return Vector2( x[n], y[n] ); }
+
+	Vector2xN operator+(const Vector2xN &b) const { return Vector2xN( x + b.x, y + b.y ); }
+	Vector2xN operator-(const Vector2xN &b) const { return Vector2xN( x - b.x, y - b.y ); }
+	Vector2xN operator*(const D &s) const { return Vector2xN( x * s, y * s ); }
+	Vector2xN operator*(const double &s) const { return *this * D(s); }
+	Vector2xN operator/(const D &s) const { return Vector2xN( x / s, y / s ); }
+
+	Vector2xN& operator+=(const Vector2xN &b) { return *this = *this + b; }
+	Vector2xN& operator-=(const Vector2xN &b) { return *this = *this - b; }
+	Vector2xN& operator*=(const D &s) { return *this = *this * s; }
+
+	D dot(const Vector2xN &b) const { return (x * b.x) + (y * b.y); }
+	D cross(const Vector2xN &b) const { return (x * b.y) - (y * b.x); }
+	D len() const { return Sqrt( (x * x) + (y * y) ); }
+
+	//a where m is set, b where it isn't
+	friend Vector2xN Select(const D &m, const Vector2xN &a, const Vector2xN &b) { return Vector2xN( Select(m, a.x, b.x), Select(m, a.y, b.y) ); }
+
+};
+
+typedef Vector2xN< Double4 > Vector2x4;
+typedef Vector2xN< Double8 > Vector2x8;
+
+#endif //VECTOR2X_H
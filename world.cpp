@@ -0,0 +1,339 @@
+//* world.cpp *//
+
+#include <vector>
+
+#include "body.h"
+#include "tilegrid.h"
+#include "worldlistener.h"
+#include "replaylog.h"
+#include "chunkstore.h"
+#include "jobsystem.h"
+#include "world.h"
+
+using namespace std;
+
+//the bodies of one step, dealt out as jobs of a run of bodies each. every job
+//records its bodies' collisions in a buffer of its own; put in the World's one
+//job after another, they're in the same order a serial step would have
+//recorded them.
+class ResolveJobs : public JobList
+{
+
+public:
+
+	World *world;
+	int per;//job n is bodies n*per .. (n+1)*per-1
+	vector< CollisionBuffer > collisions;//one per job
+
+	void Do(const int &job)
+	{
+		CollisionBuffer &buf = collisions[job];
+		buf.Clear();
+
+		Body b(Vector2(0, 0), 0);
+		b.listener = NULL;//(everything goes in buf)
+		b.collisions = &buf;
+
+		int n = world->bodies.Count();
+		int end = (n < (job+1)*per) ? n : (job+1)*per;
+		for( int k = job*per; k < end; k++ )
+		{
+			if( world->bodies.IsDead(k) )
+				continue;
+
+			world->bodies.Load(k, b);
+			world->Resolve(b);
+			world->bodies.Store(k, b);
+		}
+	}
+};
+
+//rows/cols/xw/yw are passed straight to the tile grid; the grid still has to be Build()'t
+World::World(const int &rows_in, const int &cols_in, const int &xw_in, const int &yw_in)
+{
+	tiles = new TileGrid(rows_in, cols_in, xw_in, yw_in);
+
+	padx = 0;
+	pady = 0;
+	padw = 0;
+
+	swept = 0;
+	fixed = 0;
+	single = 0;
+
+	recorder = NULL;
+
+	chunks = NULL;
+
+	listener = NULL;
+
+	jobs = NULL;
+	resolvejobs = NULL;
+
+	collisions.Reserve(COLLISION_EVENTS);
+}
+
+World::~World()
+{
+	bodies.Clear();
+
+	if( chunks != NULL )
+		chunks->Detach();
+
+	delete resolvejobs;
+	delete tiles;
+}
+
+//adds a new circle to the world, and returns its index in bodies
+int World::AddBody(Vector2 pos_in, const int &r_in)
+{
+	if( recorder != NULL )
+		recorder->AddBody(pos_in, r_in);
+	return bodies.Add(pos_in, r_in);
+}
+
+//puts body k back in play at pos_in, moving by (pos_in - oldpos_in) per step
+void World::PlaceBody(const int &k, const Vector2 &pos_in, const Vector2 &oldpos_in)
+{
+	if( recorder != NULL )
+		recorder->PlaceBody(k, pos_in, oldpos_in);
+	bodies.Place(k, pos_in, oldpos_in);
+	bodies.Revive(k);
+}
+
+//replaces the tiles with a level string (see TileGrid::SetTileStates())
+void World::LoadLevel(const string &level)
+{
+	if( recorder != NULL )
+		recorder->LoadLevel(level);
+	tiles->SetTileStates(level);
+}
+
+//seeds every random choice the world makes; the same seed and the same inputs
+//always give the same game
+void World::Seed(const unsigned int &seed)
+{
+	if( recorder != NULL )
+		recorder->Seed(seed);
+	rng.Seed(seed);
+	tiles->rng.Seed( rng.Next() );
+}
+
+//turns tiles into a window onto store, which has to be Open() already, starting
+//around chunk (ci, cj); from then on the window follows the bodies around (see
+//ChunkStore::Follow()). the grid's old size and tiles are thrown away, and
+//positions in the world are relative to the window from now on.
+void World::Stream(ChunkStore *store, const int &ci, const int &cj)
+{
+	chunks = store;
+	chunks->Attach(tiles, ci, cj);
+}
+
+//hooks l up to the grid and to the bodies
+void World::SetListener(WorldListener *l)
+{
+	listener = l;
+	tiles->listener = l;
+}
+
+//advances the simulation by one tick; this is what GameBoard::EnterFrame used to do.
+//
+//all of the bodies are integrated in one batch first, then pushed apart from
+//each other (see Broadphase). collisions against the tiles and the pad are still
+//resolved one body at a time, through a scratch Body (see BodySet::Load()).
+//
+//the collisions, and the deaths, are only recorded (in collisions) while the
+//bodies move, and acted on once they've all moved; see ApplyCollisions().
+void World::Step()
+{
+	if( recorder != NULL )
+		recorder->Tick(padx, pady, padw);
+
+	if( chunks != NULL )
+		chunks->Follow(bodies, padx, pady);
+
+	collisions.Clear();
+
+	broadphase.fixed = fixed;
+	broadphase.single = single;
+	broadphase.jobs = jobs;
+	if( fixed )
+		StepAs< Fixed >();
+	else if( single )
+		StepAs< float >();
+	else
+	{
+		bodies.IntegrateVerlet();
+		broadphase.Collide( bodies, tiles->fullcols*tiles->tw, tiles->fullrows*tiles->th, (tiles->tw < tiles->th) ? tiles->th : tiles->tw, &collisions );
+
+		if( jobs != NULL && jobs->Threads() > 1 )
+			ResolveParallel();
+		else
+		{
+			Body b(Vector2(0, 0), 0);
+			b.listener = listener;
+			b.collisions = &collisions;
+
+			int n = bodies.Count();
+			for( int k = 0; k < n; k++ )
+			{
+				if( bodies.IsDead(k) )
+					continue;
+
+				bodies.Load(k, b);
+				Resolve(b);
+				bodies.Store(k, b);
+			}
+		}
+	}
+
+	ApplyCollisions();
+}
+
+//the end of Step(): plays out the collisions it recorded, in order. each tile
+//that was hit takes the hit (see TileGrid::Knock()), and then the listener is
+//told about it, given the body as it is at the end of the step. the edges
+//around the tiles that broke are looked up once, after all of the hits.
+//
+//a tile that broke earlier in the step isn't hit again, or reported again; it
+//was only still there because the hits were put off until now.
+//
+//the bodies that died are told about last, once the tiles are done with, since
+//that's where the listener may end the game and load the next level.
+void World::ApplyCollisions()
+{
+	Body b(Vector2(0, 0), 0);
+	int n = collisions.Count();
+	for( int q = 0; q < n; q++ )
+	{
+		const CollisionEvent &e = collisions[q];
+		if( e.other == EVENT_DIED )
+			continue;
+		if( 0 <= e.other )
+		{
+			if( listener != NULL )
+				listener->BodiesCollided(e.body, e.other);
+			continue;
+		}
+
+		TileRef t;
+		if( 0 <= e.i )
+		{
+			t = TileRef(tiles, e.i, e.j);
+			if( t.ID() == TID_EMPTY )
+				continue;
+			tiles->Knock(t.k);
+		}
+
+		if( listener != NULL )
+		{
+			bodies.Load(e.body, b);
+			listener->BodyCollided(&b, t);
+		}
+	}
+
+	tiles->UpdateBroken();
+
+	if( listener == NULL )
+		return;
+	for( int q = 0; q < n; q++ )
+	{
+		const CollisionEvent &e = collisions[q];
+		if( e.other != EVENT_DIED )
+			continue;
+		bodies.Load(e.body, b);
+		listener->BodyDied(&b);
+	}
+}
+
+//the rest of Step() when fixed (T is Fixed) or single (T is float) is set. each
+//body is loaded into a scratch BodyT<T> for its integration and again for its
+//collisions, so all of its own arithmetic is in T; in between it's kept in the
+//BodySet as doubles, which a Fixed or a float goes through unchanged (see fixed.h).
+//
+//the Broadphase pushes the bodies apart from each other in T too (see
+//Broadphase::fixed), so with fixed set a game is the same everywhere however
+//many balls it has. it's always serial.
+template<class T> void World::StepAs()
+{
+	Body d(Vector2(0, 0), 0);
+	int n = bodies.Count();
+	for( int k = 0; k < n; k++ )
+	{
+		if( bodies.IsDead(k) )
+			continue;
+
+		bodies.Load(k, d);
+		BodyT< T > b(d);
+		b.IntegrateVerlet();
+		bodies.Store(k, Body(b));
+	}
+
+	broadphase.Collide( bodies, tiles->fullcols*tiles->tw, tiles->fullrows*tiles->th, (tiles->tw < tiles->th) ? tiles->th : tiles->tw, &collisions );
+
+	for( int k = 0; k < n; k++ )
+	{
+		if( bodies.IsDead(k) )
+			continue;
+
+		bodies.Load(k, d);
+		BodyT< T > b(d);
+		b.listener = listener;
+		b.collisions = &collisions;
+		Resolve(b);
+		bodies.Store(k, Body(b));
+	}
+}
+
+//collides one body (loaded into b) with the tiles and the pad, for this step
+template<class T> void World::Resolve(BodyT<T> &b)
+{
+	if( swept )
+		b.SweepCirclevsTileMap( tiles );
+	if( chunks != NULL && !b.dead && chunks->Outside((double)b.pos.x, (double)b.pos.y) )
+	{
+		//the window has left this body behind, so there aren't tiles all around
+		//it to collide with; it dies, as if it had fallen off the board
+		b.Die();
+	}
+	if( b.dead )
+		return;
+	b.CollideCirclevsTileMap( b.Cell(tiles) );
+	b.CollideCirclevsPad    ( padx, pady, padw, b.Cell(tiles) );
+}
+
+//the second half of Step() on jobs' threads: the bodies are split into runs of
+//consecutive bodies, and the runs are resolved in parallel, each one body at a
+//time in order. the bodies only read the tiles while they're resolved (the hits
+//are put off until ApplyCollisions()) and they were pushed apart from each other
+//already, so a body can't change anything another one reads, and every body
+//ends up exactly where a serial step would have put it, however many threads
+//there are.
+//
+//the collisions (and deaths) are recorded in a buffer per job, and put in the
+//World's in job order, which is body order.
+void World::ResolveParallel()
+{
+	if( resolvejobs == NULL )
+	{
+		resolvejobs = new ResolveJobs();
+		resolvejobs->world = this;
+	}
+	ResolveJobs &rj = *resolvejobs;
+
+	//a few jobs per thread, so there's something to steal
+	int n = bodies.Count();
+	rj.per = n / (jobs->Threads() * RESOLVE_JOBS) + 1;
+	int count = (n + rj.per - 1) / rj.per;
+	if( (int)rj.collisions.size() < count )
+		rj.collisions.resize(count);
+
+	jobs->Run(&rj, count);
+
+	for( int job = 0; job < count; job++ )
+	{
+		const CollisionBuffer &buf = rj.collisions[job];
+		for( int q = 0; q < buf.Count(); q++ )
+			collisions.Add( buf[q] );
+	}
+}
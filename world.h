@@ -0,0 +1,87 @@
+//* world.h *//
+
+#ifndef WORLD_H
+#define WORLD_H
+
+#include <vector>
+#include <string>
+
+#include "vector2.h"
+#include "random.h"
+#include "bodyset.h"
+#include "broadphase.h"
+#include "collisionbuffer.h"
+
+template<class T> class BodyT;
+typedef BodyT< double > Body;
+class TileGrid;
+class WorldListener;
+class ReplayLog;
+class ChunkStore;
+class JobSystem;
+class ResolveJobs;
+
+const int RESOLVE_JOBS = 8;//jobs per thread Step() deals the bodies out as, when it has a JobSystem
+
+//a World is everything the simulation needs for one game: the tile grid, the
+//bodies moving through it and the pad. it has no Qt dependency, so it can be
+//stepped as fast as the CPU allows (batch jobs, benchmarks) or driven by the
+//GameBoard, which draws it.
+class World
+{
+
+public:
+
+	TileGrid *tiles;
+	BodySet bodies;
+	Broadphase broadphase;
+
+	int padx;//pad rect; the Pad widget pushes its geometry in here before each step
+	int pady;
+	int padw;
+
+	int swept;//if set, bodies are swept along their motion against the tiles (see Body::SweepCirclevsTileMap())
+
+	int fixed;//if set, bodies are integrated and collided, with the tiles and each other, in fixed point (BodyFixed), so a game comes out the same on every compiler and CPU
+
+	int single;//if set (and fixed isn't), the same in float (BodyF); for measuring what the precision costs a whole game (see bench_precision.cpp)
+
+	Random rng;//for the game's own random choices (i.e where a ball respawns); the tiles have their own
+
+	ReplayLog *recorder;//if set, every input to the world is logged here; may be NULL
+
+	ChunkStore *chunks;//if set, tiles is a window onto this streamed world (see ChunkStore); may be NULL
+
+	WorldListener *listener;//told about collisions, deaths and tile changes; may be NULL
+
+	JobSystem *jobs;//if set, bodies are pushed apart on its threads, a band of cells per job (see Broadphase), then resolved against the tiles, a run of bodies per job (see ResolveParallel()); may be NULL
+
+	CollisionBuffer collisions;//every collision of the last Step(), in order, with its normal and how hard it was; for whoever wants more than the listener is told (i.e sound, telemetry)
+
+	World(const int &rows_in, const int &cols_in, const int &xw_in, const int &yw_in);
+	~World();
+
+	int AddBody(Vector2 pos_in, const int &r_in);
+	void PlaceBody(const int &k, const Vector2 &pos_in, const Vector2 &oldpos_in);
+	void LoadLevel(const std::string &level);
+	void Seed(const unsigned int &seed);
+	void Stream(ChunkStore *store, const int &ci, const int &cj);
+	void SetListener(WorldListener *l);
+
+	void Step();
+	template<class T> void Resolve(BodyT<T> &b);
+
+private:
+
+	ResolveJobs *resolvejobs;//what Step() hands to jobs; made the first time it's needed
+
+	void ResolveParallel();
+	template<class T> void StepAs();
+	void ApplyCollisions();
+
+	World(const World&);
+	World& operator=(const World&);
+
+};
+
+#endif //WORLD_H
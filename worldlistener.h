@@ -0,0 +1,26 @@
+//* worldlistener.h *//
+
+#ifndef WORLDLISTENER_H
+#define WORLDLISTENER_H
+
+template<class T> class BodyT;
+typedef BodyT< double > Body;
+class TileRef;
+class TileGrid;
+
+//the simulation never talks to widgets or sound directly; whoever wants to
+//know about things happening in a World (i.e the GameBoard) implements this
+//and hooks itself up as the listener. every callback does nothing by default.
+class WorldListener
+{
+public:
+	virtual ~WorldListener() { }
+
+	virtual void TileChanged(const TileRef & /* t */) { }//ID or HP of a tile changed; its look may have changed
+	virtual void MapChanged(TileGrid * /* g */) { }//many tiles of g changed at once (i.e a level was loaded); redraw all of them
+	virtual void BodyCollided(Body * /* b */, const TileRef & /* t */) { }//t is a null TileRef when b hit something that isn't a tile (i.e the pad)
+	virtual void BodyDied(Body * /* b */) { }//b fell out of the bottom of the map; told last in a step, so it may load another level
+	virtual void BodiesCollided(const int & /* a */, const int & /* b */) { }//bodies a and b (indices into the World's BodySet) bumped into each other
+};
+
+#endif //WORLDLISTENER_H